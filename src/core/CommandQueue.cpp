@@ -0,0 +1,89 @@
+#include "CommandQueue.h"
+#include <algorithm>
+#include <utility>
+
+CommandQueue::~CommandQueue() {
+    Drain([](SceneCommand&) {});
+}
+
+void CommandQueue::Push(SceneCommand* command) {
+    command->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(command->next, command, std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+    }
+}
+
+SceneCommand* CommandQueue::TakeOldestFirst() {
+    SceneCommand* newestFirst = head.exchange(nullptr, std::memory_order_acquire);
+    SceneCommand* oldestFirst = nullptr;
+    while (newestFirst) {
+        SceneCommand* next = newestFirst->next;
+        newestFirst->next = oldestFirst;
+        oldestFirst = newestFirst;
+        newestFirst = next;
+    }
+    return oldestFirst;
+}
+
+BodyHandle CommandQueue::AddBody(RigidBody body) {
+    BodyHandle handle = ReserveHandles(1);
+    AddBody(std::move(body), handle);
+    return handle;
+}
+
+void CommandQueue::AddBody(RigidBody body, BodyHandle handle) {
+    body.id = handle;
+    Push(new SceneCommand{CommandType::AddBody, handle, std::move(body)});
+}
+
+BodyHandle CommandQueue::AddBodies(std::span<const BodyDesc> descs) {
+    BodyHandle first = ReserveHandles((uint32_t)descs.size());
+    SceneCommand* command = new SceneCommand{CommandType::AddBodies, first};
+    command->descs.assign(descs.begin(), descs.end());
+    Push(command);
+    return first;
+}
+
+void CommandQueue::RemoveBody(BodyHandle body) {
+    Push(new SceneCommand{CommandType::RemoveBody, body});
+}
+
+void CommandQueue::RemoveBodies(std::span<const BodyHandle> bodies) {
+    SceneCommand* command = new SceneCommand{CommandType::RemoveBodies};
+    command->handles.assign(bodies.begin(), bodies.end());
+    // Sorts after adds of any of these bodies under DrainByHandle
+    if (!bodies.empty()) command->body = *std::max_element(bodies.begin(), bodies.end());
+    Push(command);
+}
+
+void CommandQueue::RemoveAll() {
+    Push(new SceneCommand{CommandType::RemoveAll});
+}
+
+void CommandQueue::ApplyImpulse(BodyHandle body, const glm::vec3& impulse) {
+    SceneCommand* command = new SceneCommand{CommandType::ApplyImpulse, body};
+    command->vector = impulse;
+    Push(command);
+}
+
+void CommandQueue::ApplyImpulseAt(BodyHandle body, const glm::vec3& impulse, const glm::vec3& worldPoint) {
+    SceneCommand* command = new SceneCommand{CommandType::ApplyImpulse, body};
+    command->vector = impulse;
+    command->point = worldPoint;
+    command->atPoint = true;
+    Push(command);
+}
+
+void CommandQueue::SetTransform(BodyHandle body, const glm::vec3& position, const glm::quat& orientation) {
+    SceneCommand* command = new SceneCommand{CommandType::SetTransform, body};
+    command->vector = position;
+    command->orientation = orientation;
+    Push(command);
+}
+
+void CommandQueue::CarveVoxels(BodyHandle body, const glm::ivec3& center, int radius) {
+    SceneCommand* command = new SceneCommand{CommandType::CarveVoxels, body};
+    command->voxel = center;
+    command->radius = radius;
+    Push(command);
+}
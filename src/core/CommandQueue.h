@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "physics/bodies/RigidBody.h"
+
+// Bodies are addressed by id. The scene's queue numbers the bodies posted to
+// it from its own sequence, so a handle is valid as soon as AddBody returns,
+// doesn't depend on bodies built elsewhere, and is only reused after
+// Scene::SetDeterministic starts the sequence over.
+using BodyHandle = uint32_t;
+
+enum class CommandType { AddBody, AddBodies, RemoveBody, RemoveBodies, RemoveAll, ApplyImpulse, SetTransform, CarveVoxels };
+
+struct SceneCommand {
+    CommandType type = CommandType::AddBody;
+    BodyHandle body = 0;
+    std::optional<RigidBody> newBody = std::nullopt;  // AddBody
+    std::vector<BodyDesc> descs = {};        // AddBodies, ids from body on up
+    std::vector<BodyHandle> handles = {};    // RemoveBodies, whose body is the largest of them
+    glm::vec3 vector = glm::vec3(0.0f);  // Impulse or position
+    glm::vec3 point = glm::vec3(0.0f);   // World point an impulse acts at
+    bool atPoint = false;
+    glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::ivec3 voxel = glm::ivec3(0);  // Carve center, in voxels
+    int radius = 0;
+    SceneCommand* next = nullptr;
+};
+
+// Scene edits any thread can post; the scene applies them in order at the
+// start of its next step, so nothing touches `bodies` mid-step. Posting is a
+// lock-free push onto a list the stepping thread takes whole.
+class CommandQueue {
+public:
+    CommandQueue() = default;
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+    ~CommandQueue();
+
+    // Gives the body the next handle, replacing whatever id it was built with
+    BodyHandle AddBody(RigidBody body);
+    // With a handle from ReserveHandles, so handles can be handed out in a
+    // fixed order and the bodies posted from any thread
+    void AddBody(RigidBody body, BodyHandle handle);
+    // One command for the whole batch; the bodies get handles first,
+    // first + 1, ... in span order. Returns first.
+    BodyHandle AddBodies(std::span<const BodyDesc> descs);
+    // count consecutive handles for later AddBody calls; returns the first
+    BodyHandle ReserveHandles(uint32_t count) { return nextHandle.fetch_add(count); }
+    void RemoveBody(BodyHandle body);
+    void RemoveBodies(std::span<const BodyHandle> bodies);
+    void RemoveAll();
+    void ApplyImpulse(BodyHandle body, const glm::vec3& impulse);
+    void ApplyImpulseAt(BodyHandle body, const glm::vec3& impulse, const glm::vec3& worldPoint);
+    void SetTransform(BodyHandle body, const glm::vec3& position, const glm::quat& orientation);
+    // Clears every voxel within radius of center in a voxel world body
+    void CarveVoxels(BodyHandle body, const glm::ivec3& center, int radius);
+
+    // Next handle handed out, and the point Scene::SetDeterministic and
+    // rollback restart the sequence from
+    BodyHandle NextHandle() const { return nextHandle.load(); }
+    void RestartHandles(BodyHandle next) { nextHandle.store(next); }
+
+    // Stepping thread only: runs fn on everything posted so far, oldest first
+    template <class Fn>
+    void Drain(Fn&& fn) {
+        for (SceneCommand* command = TakeOldestFirst(); command;) {
+            SceneCommand* next = command->next;
+            fn(*command);
+            delete command;
+            command = next;
+        }
+    }
+
+    // Like Drain, but in an order that doesn't depend on how posting threads
+    // interleaved: sorted by body handle between RemoveAll commands, posting
+    // order kept for the same handle. Deterministic as long as each body's
+    // commands come from one thread and handles are taken in a fixed order.
+    template <class Fn>
+    void DrainByHandle(Fn&& fn) {
+        std::vector<SceneCommand*> batch;
+        for (SceneCommand* command = TakeOldestFirst(); command; command = command->next) {
+            batch.push_back(command);
+        }
+        auto byHandle = [](const SceneCommand* l, const SceneCommand* r) { return l->body < r->body; };
+        auto begin = batch.begin();
+        for (auto it = batch.begin(); it != batch.end(); ++it) {
+            if ((*it)->type != CommandType::RemoveAll) continue;
+            std::stable_sort(begin, it, byHandle);
+            begin = it + 1;
+        }
+        std::stable_sort(begin, batch.end(), byHandle);
+
+        for (SceneCommand* command : batch) {
+            fn(*command);
+            delete command;
+        }
+    }
+
+private:
+    void Push(SceneCommand* command);
+    SceneCommand* TakeOldestFirst();  // Detaches the whole list and reverses it
+
+    std::atomic<SceneCommand*> head{nullptr};  // Newest first
+    std::atomic<BodyHandle> nextHandle{0};
+};
@@ -0,0 +1,130 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    // One ParallelFor call; lives on the caller's stack until every user is gone
+    struct Batch {
+        void (*run)(void*, int, int);
+        void* context;
+        int count;
+        int grain;
+        std::atomic<int> next{0};
+        int users = 0;  // Workers holding a pointer to this batch, under poolMutex
+    };
+
+    struct Pool {
+        std::mutex mutex;
+        std::condition_variable workReady;
+        std::condition_variable batchReleased;
+        std::deque<Batch*> queue;
+        std::vector<std::thread> workers;
+        bool stopping = false;
+
+        ~Pool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            workReady.notify_all();
+            for (std::thread& worker : workers) worker.join();
+        }
+    };
+
+    Pool pool;
+    std::once_flag poolStarted;
+
+    // Claims chunks until the batch runs dry
+    void Work(Batch& batch) {
+        for (;;) {
+            int begin = batch.next.fetch_add(batch.grain, std::memory_order_relaxed);
+            if (begin >= batch.count) return;
+            batch.run(batch.context, begin, std::min(begin + batch.grain, batch.count));
+        }
+    }
+
+    void Unqueue(Batch* batch) {
+        auto it = std::find(pool.queue.begin(), pool.queue.end(), batch);
+        if (it != pool.queue.end()) pool.queue.erase(it);
+    }
+
+    // Works on the oldest queued batch; called and returns with lock held
+    void Help(std::unique_lock<std::mutex>& lock) {
+        Batch* batch = pool.queue.front();
+        batch->users++;
+        lock.unlock();
+        Work(*batch);
+        lock.lock();
+
+        // Dry now, so nobody else should pick it up
+        Unqueue(batch);
+        if (--batch->users == 0) pool.batchReleased.notify_all();
+    }
+
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(pool.mutex);
+        for (;;) {
+            pool.workReady.wait(lock, [] { return pool.stopping || !pool.queue.empty(); });
+            if (pool.stopping) return;
+            Help(lock);
+        }
+    }
+
+    void StartPool() {
+        int count = std::max(1, (int)std::thread::hardware_concurrency()) - 1;
+        for (int i = 0; i < count; i++) pool.workers.emplace_back(WorkerLoop);
+    }
+}
+
+int JobSystem::WorkerCount() {
+    std::call_once(poolStarted, StartPool);
+    return (int)pool.workers.size();
+}
+
+void JobSystem::Dispatch(int count, int grain, void (*run)(void*, int, int), void* context) {
+    grain = std::max(grain, 1);
+    if (count <= grain || WorkerCount() == 0) {
+        run(context, 0, count);
+        return;
+    }
+
+    Batch batch;
+    batch.run = run;
+    batch.context = context;
+    batch.count = count;
+    batch.grain = grain;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.queue.push_back(&batch);
+    }
+    pool.workReady.notify_all();
+
+    Work(batch);
+
+    // Every chunk is claimed; wait for workers still running theirs
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    Unqueue(&batch);
+    pool.batchReleased.wait(lock, [&] { return batch.users == 0; });
+}
+
+void JobSystem::Wait(bool (*done)(void*), void* context) {
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    for (;;) {
+        pool.workReady.wait(lock, [&] { return done(context) || !pool.queue.empty(); });
+        if (done(context)) return;
+        Help(lock);
+    }
+}
+
+void JobSystem::Wake() {
+    {
+        // A waiter has either checked done() already or is asleep and gets notified
+        std::lock_guard<std::mutex> lock(pool.mutex);
+    }
+    pool.workReady.notify_all();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <type_traits>
+
+// Fixed pool of worker threads shared by everything that wants to go wide.
+// Workers start on first use, one per hardware thread beyond the caller's.
+class JobSystem {
+public:
+    // Runs fn(begin, end) over [0, count) in chunks of at most grain items.
+    // The calling thread works too and returns once every chunk is done, so
+    // fn may capture locals by reference and nested calls can't deadlock.
+    template <class Fn>
+    static void ParallelFor(int count, int grain, Fn&& fn) {
+        if (count <= 0) return;
+        auto run = [](void* context, int begin, int end) {
+            (*static_cast<std::remove_reference_t<Fn>*>(context))(begin, end);
+        };
+        Dispatch(count, grain, run, (void*)&fn);
+    }
+
+    // Blocks until done() is true, running queued ParallelFor chunks in the
+    // meantime instead of sleeping. done() is checked under the pool's lock,
+    // so whoever makes it true must call Wake() afterwards.
+    template <class Done>
+    static void WaitHelping(Done&& done) {
+        auto check = [](void* context) {
+            return (*static_cast<std::remove_reference_t<Done>*>(context))();
+        };
+        Wait(check, (void*)&done);
+    }
+
+    static void Wake();
+
+    static int WorkerCount();
+
+private:
+    // Type-erased so submitting work never allocates
+    static void Dispatch(int count, int grain, void (*run)(void*, int, int), void* context);
+    static void Wait(bool (*done)(void*), void* context);
+};
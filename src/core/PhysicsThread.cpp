@@ -0,0 +1,55 @@
+#include "PhysicsThread.h"
+#include <algorithm>
+#include <iostream>
+
+PhysicsThread::PhysicsThread(Scene& scene, float fixedDeltaTime)
+    : scene(scene), fixedDeltaTime(fixedDeltaTime) {}
+
+PhysicsThread::~PhysicsThread() {
+    Stop();
+}
+
+void PhysicsThread::Start() {
+    if (running.exchange(true)) return;
+    lastStepTime = Clock::now().time_since_epoch().count();
+    thread = std::thread(&PhysicsThread::Run, this);
+}
+
+void PhysicsThread::Stop() {
+    if (!running.exchange(false)) return;
+    thread.join();
+}
+
+float PhysicsThread::InterpolationAlpha() const {
+    Clock::duration sinceStep = Clock::now().time_since_epoch() - Clock::duration(lastStepTime.load());
+    float alpha = std::chrono::duration<float>(sinceStep).count() / fixedDeltaTime;
+    return std::clamp(alpha, 0.0f, 1.0f);
+}
+
+void PhysicsThread::Run() {
+    const Clock::duration step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(fixedDeltaTime));
+    Clock::time_point due = Clock::now();
+
+    while (running) {
+        int steps = 0;
+        while (Clock::now() >= due && steps < MAX_STEPS_PER_FRAME) {
+            {
+                std::lock_guard<std::mutex> lock(sceneMutex);
+                scene.StepPhysicsWithIslands(fixedDeltaTime);
+            }
+            lastStepTime = due.time_since_epoch().count();
+            due += step;
+            steps++;
+        }
+
+        if (Clock::now() >= due) {
+            // Still behind after the cap: let the simulation run slow instead
+            std::cout << "⚠️ Physics fell behind, dropping "
+                      << std::chrono::duration<float>(Clock::now() - due).count() << " s\n";
+            due = Clock::now();
+            lastStepTime = due.time_since_epoch().count();
+        }
+
+        std::this_thread::sleep_until(due);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "Scene.h"
+
+// Steps a Scene at a fixed rate on its own thread, so rendering never waits
+// on a step. Other threads edit bodies through Scene::Commands() and read
+// through the published frames, queries and poses; SceneMutex() is only for
+// code that must touch the scene directly.
+class PhysicsThread {
+public:
+    // Steps run back to back to catch up are capped; time beyond that is
+    // dropped instead of feeding a spiral of ever longer catch-ups
+    static constexpr int MAX_STEPS_PER_FRAME = 4;
+
+    PhysicsThread(Scene& scene, float fixedDeltaTime);
+    ~PhysicsThread();
+
+    void Start();
+    void Stop();
+
+    std::mutex& SceneMutex() { return sceneMutex; }
+
+    // Accumulator remainder as a fraction of a step: how far past the latest
+    // published step the wall clock is, for Scene::Render
+    float InterpolationAlpha() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void Run();
+
+    Scene& scene;
+    float fixedDeltaTime;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::mutex sceneMutex;
+    std::atomic<Clock::rep> lastStepTime{0};  // When the latest step was due
+};
@@ -0,0 +1,70 @@
+#include "PoseBuffer.h"
+#include <utility>
+
+namespace {
+    // Slot state bit the writer sets while refilling; the rest count readers
+    constexpr uint32_t WRITING = 0x80000000u;
+}
+
+PoseBuffer::Reader::Reader(Reader&& other) noexcept : slot(std::exchange(other.slot, nullptr)) {}
+
+PoseBuffer::Reader& PoseBuffer::Reader::operator=(Reader&& other) noexcept {
+    if (this != &other) {
+        if (slot) slot->state.fetch_sub(1, std::memory_order_acq_rel);
+        slot = std::exchange(other.slot, nullptr);
+    }
+    return *this;
+}
+
+PoseBuffer::Reader::~Reader() {
+    if (slot) slot->state.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+const PoseSnapshot& PoseBuffer::Reader::operator*() const {
+    return slot->snapshot;
+}
+
+const PoseSnapshot* PoseBuffer::Reader::operator->() const {
+    return &slot->snapshot;
+}
+
+PoseSnapshot* PoseBuffer::BeginWrite() {
+    int current = latest.load(std::memory_order_relaxed);
+    for (int i = 0; i < SLOT_COUNT; i++) {
+        if (i == current) continue;
+        // Fails if any reader still holds it, even one that is about to back off
+        uint32_t expected = 0;
+        if (slots[i].state.compare_exchange_strong(expected, WRITING, std::memory_order_acq_rel)) {
+            writing = i;
+            return &slots[i].snapshot;
+        }
+    }
+    return nullptr;
+}
+
+void PoseBuffer::EndWrite() {
+    if (writing < 0) return;
+    // Publish before unlocking, so nobody can read the new snapshot through a
+    // stale index and then see an older one on their next Acquire
+    latest.store(writing, std::memory_order_release);
+    slots[writing].state.fetch_sub(WRITING, std::memory_order_acq_rel);
+    writing = -1;
+}
+
+PoseBuffer::Reader PoseBuffer::Acquire() const {
+    for (;;) {
+        int index = latest.load(std::memory_order_acquire);
+        if (index < 0) return Reader();
+
+        // The slot may have been claimed for refilling since we read latest,
+        // or be just published and not yet unlocked; either way, look again
+        Slot& slot = slots[index];
+        if ((slot.state.fetch_add(1, std::memory_order_acq_rel) & WRITING) == 0) return Reader(&slot);
+        slot.state.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+uint64_t PoseBuffer::LatestVersion() const {
+    Reader reader = Acquire();
+    return reader ? reader->version : 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// Just the motion state of one body, for threads that only follow poses
+struct BodyPose {
+    uint32_t id;
+    glm::vec3 position;
+    glm::quat orientation;
+    glm::vec3 velocity;
+    glm::vec3 angularVelocity;
+    bool isSleeping;
+};
+
+struct PoseSnapshot {
+    uint64_t version = 0;  // Step that produced it; increases by one per publish
+    uint64_t stateHash = 0;  // Scene::LastStateHash of that step
+    std::vector<BodyPose> poses;
+};
+
+// Hands the latest PoseSnapshot from one writer (the stepping thread) to any
+// number of readers without locks. Each slot counts the readers holding it;
+// the writer only refills a slot that is neither the latest nor held, so a
+// snapshot never changes under a reader and readers never wait on a step.
+class PoseBuffer {
+    struct Slot {
+        // Readers holding the slot, plus WRITING while the writer fills it
+        std::atomic<uint32_t> state{0};
+        PoseSnapshot snapshot;
+    };
+
+public:
+    // One slot is always the latest, so up to SLOT_COUNT - 1 readers can sit
+    // on older snapshots before a publish has to be skipped
+    static constexpr int SLOT_COUNT = 8;
+
+    // Keeps a snapshot alive until destroyed; hold it briefly
+    class Reader {
+    public:
+        Reader() = default;
+        Reader(Reader&& other) noexcept;
+        Reader& operator=(Reader&& other) noexcept;
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        ~Reader();
+
+        explicit operator bool() const { return slot != nullptr; }
+        const PoseSnapshot& operator*() const;
+        const PoseSnapshot* operator->() const;
+
+    private:
+        friend class PoseBuffer;
+        Slot* slot = nullptr;
+        explicit Reader(Slot* slot) : slot(slot) {}
+    };
+
+    // Writer side. BeginWrite returns a free snapshot to fill in place (its
+    // vectors keep their capacity) or nullptr if readers hold every other slot.
+    PoseSnapshot* BeginWrite();
+    void EndWrite();
+
+    // Empty only before the first publish
+    Reader Acquire() const;
+    uint64_t LatestVersion() const;
+
+private:
+    mutable std::array<Slot, SLOT_COUNT> slots;
+    std::atomic<int> latest{-1};
+    int writing = -1;  // Writer thread only
+};
+
@@ -6,148 +6,646 @@
 #include <cstdlib>
 #include <vector>
 #include <numeric>   // for std::iota
+#include <limits>
+#include <cstring>
+#include <random>
+#include <iterator>
+#include <memory>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>  // or any other glm/gtx/ include
 #include <glm/gtx/string_cast.hpp>  // Needed for glm::to_string
 
 #include "Scene.h"
+#include "JobSystem.h"
+#include "TaskGraph.h"
 #include "physics/collision/ContactSolver.h"
 #include "physics/shapes/BoxShape.h"
 #include "physics/collision/ContactManifold.h"
 #include "physics/collision/SATCollision.h"
+#include "physics/collision/Broadphase.h"
+#include "physics/collision/CollisionDispatch.h"
+#include "physics/shapes/ShapeRegistry.h"
 #include <cmath>
 #include <iostream>
 
+// === Substepping (shared by global and per-island subdivision) ===
+constexpr float MAX_SAFE_SPEED = 3.0f;      // Lower threshold for better collision detection
+constexpr int MAX_SUBSTEPS = 8;
+constexpr float BROADPHASE_MARGIN = 0.05f;  // Covers rotation and gravity over one frame
+const glm::vec3 GRAVITY(0.0f, -9.81f, 0.0f);
+constexpr int BULK_INERTIA_GRAIN = 1024;     // Bodies per job when a batch computes mass properties
+constexpr int SWEPT_AABB_GRAIN = 1024;       // Bodies per job when sweeping AABBs for the broadphase
+constexpr int NARROWPHASE_GRAIN = 64;        // Pairs per chunk, each with its own output buffers
+constexpr uint64_t STATE_HASH_BASIS = 0xCBF29CE484222325ull;  // FNV-1a 64-bit
+constexpr uint64_t STATE_HASH_PRIME = 0x100000001B3ull;
+
 Scene::Scene() {
-    RigidBody floor(0.0f, glm::vec3(0.0f, -1.0f, 0.0f));
-    floor.SetShapeAndSize(glm::vec3(40.0f, 2.0f, 40.0f));
-    floor.color = glm::vec3(0.3f, 0.8f, 0.3f);
-    floor.isStatic = true;
-    floor.velocity = glm::vec3(0.0f);
-    floor.hasAwakened = true;  // ✅ mark floor as always awakened
-    floor.orientation = glm::quat(1, 0, 0, 0);              // 🔒 Reset rotation
-    floor.angularVelocity = glm::vec3(0.0f);                // 🔒 Prevent rotation
-    floor.inverseInertiaTensor = glm::mat3(0.0f);           // 🔒 Freeze inertia
-    /*AABB floorAABB = floor.GetAABB();
-    std::cout << "Floor AABB: Min=" << glm::to_string(floorAABB.min)
-              << ", Max=" << glm::to_string(floorAABB.max) << "\n";*/
-    bodies.push_back(floor);
+    // Infinite ground: boxes can't slide off an edge, and it never enters the broadphase
+    RigidBody ground(BodyDesc{}, RigidBody::NO_ID);
+    ground.SetPlane(glm::vec3(0.0f, 1.0f, 0.0f), 0.0f);
+    ground.color = glm::vec3(0.3f, 0.8f, 0.3f);
+    ground.hasAwakened = true;
+    groundPlanes.push_back(ground);
+    colorSeed = std::random_device{}();
+    SpawnTestBox();
+    PublishStep();
+}
+
+Scene::~Scene() {
+    if (!asyncThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        asyncStopping = true;
+    }
+    asyncQueued.notify_all();
+    asyncThread.join();
+}
+
+void Scene::SetDeterministic(uint64_t seed) {
+    deterministic = true;
+    colorSeed = seed;
+    // Empty world and handles from 0, so every peer or replay gives the same
+    // commands the same handles whatever this scene did before
+    commands.RemoveAll();
+    commands.RestartHandles(0);
+}
+
+StepHandle Scene::StepAsync(float dt) {
+    auto state = std::make_shared<StepState>();
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        if (!asyncThread.joinable()) asyncThread = std::thread(&Scene::AsyncStepLoop, this);
+        asyncSteps.emplace_back(dt, state);
+    }
+    asyncQueued.notify_one();
+    return StepHandle(state);
+}
+
+void Scene::AsyncStepLoop() {
+    std::unique_lock<std::mutex> lock(asyncMutex);
+    for (;;) {
+        asyncQueued.wait(lock, [this] { return asyncStopping || !asyncSteps.empty(); });
+        if (asyncSteps.empty()) return;  // Stopping, and every queued step is done
+
+        auto [dt, state] = std::move(asyncSteps.front());
+        asyncSteps.pop_front();
+        lock.unlock();
+
+        StepPhysicsWithIslands(dt);
+        // Only this thread publishes, so these are still the step's own
+        state->Complete(GetQuery(), stepCount - 1, LastStateHash());
+
+        lock.lock();
+    }
 }
 
 void Scene::StepPhysics(float dt) {
     dt = std::clamp(dt, 0.001f, 0.016f);
 
     std::cout << "\n====================[ StepPhysics ]====================\n";
+    ApplyCommands();
+    pairCache.BeginFrame();
+    ApplyVoxelEdits();
+    transforms.Update(bodies);
 
     // 1. APPLY FORCES AND INTEGRATE VELOCITIES FIRST
-    for (RigidBody& body : bodies) {
-        if (body.isStatic || body.isSleeping) continue;
-
-        const glm::vec3 gravity(0.0f, -9.81f, 0.0f);
-        body.ApplyForce(gravity * body.mass);
-
-        // Integrate velocities (but NOT positions yet)
-        body.IntegrateVelocity(dt);
-        body.IntegrateAngularVelocity(dt);
-
-        // DEBUG: Check for fast-moving objects
-        float speed = glm::length(body.velocity);
-        if (speed > 10.0f) {
-            std::cout << "⚠️ Fast object detected: speed=" << speed
-                      << " pos=" << glm::to_string(body.position) << std::endl;
-        }
+    for (int i = 0; i < (int)bodies.size(); ++i) {
+        IntegrateVelocities(i, dt);
     }
 
     // 2. COLLISION DETECTION AND RESPONSE
     std::vector<ContactManifold> manifolds;
-    int potentialPairs = 0, aabbPass = 0, satPass = 0;
+    std::vector<BodyPair> candidates;
+    int potentialPairs = 0;
 
     for (int i = 0; i < bodies.size(); ++i) {
         for (int j = i + 1; j < bodies.size(); ++j) {
             ++potentialPairs;
-            const AABB& aabbA = bodies[i].GetAABB();
-            const AABB& aabbB = bodies[j].GetAABB();
+            const AABB& aabbA = transforms.worldAABBs[i];
+            const AABB& aabbB = transforms.worldAABBs[j];
 
             if (!aabbA.Overlaps(aabbB)) {
                 continue;
             }
 
-            ++aabbPass;
             std::cout << "✅ AABB overlap: body " << i << " and body " << j << "\n";
-
-            ContactManifold m = SATCollision::DetectCollision(bodies[i], bodies[j]);
-            if (m.hasCollision) {
-                ++satPass;
-                std::cout << "✅ SAT collision detected. Contacts: " << m.contacts.size()
-                          << ", Penetration: " << m.penetration << "\n";
-                manifolds.push_back(m);
-            }
+            candidates.push_back({i, j});
         }
     }
 
+    DetectPairs(candidates, manifolds, nullptr);
+    int aabbPass = (int)candidates.size(), satPass = (int)manifolds.size();
+
+    for (int i = 0; i < (int)bodies.size(); ++i) {
+        CollidePlanes(i, manifolds);
+    }
+
     std::cout << "🔍 Pair checks: " << potentialPairs
               << ", AABB pass: " << aabbPass
               << ", SAT pass: " << satPass << "\n";
 
     // 3. RESOLVE COLLISIONS
+    ResolveManifolds(manifolds, dt);
+
+    lastFrameManifolds = manifolds;
+    // 4. INTEGRATE POSITIONS ONLY ONCE (AFTER collision resolution)
+    for (RigidBody& body : bodies) {
+        IntegratePositions(body, dt);
+    }
+
+    PublishStep();
+    std::cout << "====================[ End StepPhysics ]====================\n";
+}
+
+void Scene::IntegrateVelocities(int index, float dt) {
+    RigidBody& body = bodies[index];
+    if (body.isStatic || body.isSleeping) return;
+
+    body.ApplyForce(GRAVITY * body.mass);
+
+    // Integrate velocities (but NOT positions yet)
+    body.IntegrateVelocity(dt);
+    body.IntegrateAngularVelocity(dt, transforms.worldInvInertia[index]);
+
+    // DEBUG: Check for fast-moving objects
+    float speed = glm::length(body.velocity);
+    if (speed > 10.0f) {
+        std::cout << "⚠️ Fast object detected: speed=" << speed
+                  << " pos=" << glm::to_string(body.position) << std::endl;
+    }
+}
+
+void Scene::ResolveManifolds(std::vector<ContactManifold>& manifolds, float dt) {
     for (ContactManifold& manifold : manifolds) {
         if (!manifold.hasCollision || manifold.contacts.empty()) continue;
 
         for (const ContactPoint& cp : manifold.contacts) {
-            solver.Resolve(*manifold.a, *manifold.b, cp.point, cp.normal, cp.penetration, dt);
+            ResolveContact(*manifold.a, *manifold.b, cp.point, cp.normal, cp.penetration, dt);
         }
     }
+}
 
-    lastFrameManifolds = manifolds;
-    // 4. INTEGRATE POSITIONS ONLY ONCE (AFTER collision resolution)
-    for (RigidBody& body : bodies) {
-        if (body.isStatic || body.isSleeping) continue;
-
-        // NOW integrate positions with the corrected velocities
-        body.IntegratePosition(dt);
-        body.IntegrateOrientation(dt);
-
-        // Sleep/wake logic
-        float velSq = glm::length2(body.velocity);
-        float angVelSq = glm::length2(body.angularVelocity);
-        const float velTol = 0.0001f;
-        const float angVelTol = 0.0001f;
-
-        if (!body.hasAwakened && (velSq > 0.001f || angVelSq > 0.001f)) {
-            body.hasAwakened = true;
-            body.color = glm::vec3(
-                0.2f + static_cast<float>(rand()) / RAND_MAX * 0.8f,
-                0.2f + static_cast<float>(rand()) / RAND_MAX * 0.8f,
-                0.2f + static_cast<float>(rand()) / RAND_MAX * 0.8f
-            );
-        }
-
-        if (velSq < velTol && angVelSq < angVelTol) {
-            body.sleepCounter++;
-            if (body.sleepCounter > body.sleepCounterThreshold) {
-                body.isSleeping = true;
-                body.velocity = glm::vec3(0.0f);
-                body.angularVelocity = glm::vec3(0.0f);
-                std::cout << "💤 Body sleeping\n";
+void Scene::ResolveContact(RigidBody& a, RigidBody& b, const glm::vec3& point,
+                           const glm::vec3& normal, float penetration, float dt) {
+    solver.Resolve(a, b, WorldInvInertiaOf(a), WorldInvInertiaOf(b), point, normal, penetration, dt);
+}
+
+const glm::mat3& Scene::WorldInvInertiaOf(const RigidBody& body) const {
+    // Static bodies (including ground planes, which aren't in `bodies`) never rotate
+    static const glm::mat3 zero(0.0f);
+    if (body.isStatic) return zero;
+    return transforms.worldInvInertia[&body - bodies.data()];
+}
+
+void Scene::CollidePlanes(int index, std::vector<ContactManifold>& manifolds) {
+    const RigidBody& body = bodies[index];
+    if (body.isStatic || body.isSleeping) return;  // A plane never wakes anything
+
+    static const glm::mat3 identity(1.0f);
+    for (const RigidBody& plane : groundPlanes) {
+        ContactManifold m = CollisionDispatch::Detect(plane, identity, body, transforms.rotations[index], pairCache);
+        if (m.hasCollision) {
+            manifolds.push_back(m);
+        }
+    }
+}
+
+void Scene::ApplyCommands() {
+    // Lookups are built on first use and kept current through the batch;
+    // removals only mark, so indices hold until the sweep at the end
+    std::unordered_map<uint32_t, int> indexOf;
+    bool indexed = false;
+    std::vector<uint8_t> removed;
+    bool removedAny = false;
+    bool addedAny = false;
+    auto find = [&](BodyHandle handle) -> RigidBody* {
+        if (!indexed) {
+            indexOf.reserve(bodies.size());
+            for (int i = 0; i < (int)bodies.size(); i++) indexOf[bodies[i].id] = i;
+            indexed = true;
+        }
+        auto it = indexOf.find(handle);
+        return it != indexOf.end() ? &bodies[it->second] : nullptr;
+    };
+    auto markRemoved = [&](int index) {
+        removed.resize(bodies.size(), 0);
+        removed[index] = 1;
+        removedAny = true;
+    };
+
+    auto apply = [&](SceneCommand& command) {
+        if (command.type == CommandType::AddBody) {
+            bodies.push_back(std::move(*command.newBody));
+            if (indexed) indexOf[command.body] = (int)bodies.size() - 1;
+            addedAny = true;
+            return;
+        }
+        if (command.type == CommandType::AddBodies) {
+            int first = (int)bodies.size();
+            int count = (int)command.descs.size();
+            if (bodies.capacity() < bodies.size() + count) {
+                bodies.reserve(std::max(bodies.size() + count, bodies.capacity() * 2));
             }
-        } else {
-            body.sleepCounter = 0;
+            for (int i = 0; i < count; i++) {
+                bodies.emplace_back(command.descs[i], command.body + i);
+                if (indexed) indexOf[command.body + i] = first + i;
+            }
+            // Mass properties for the whole batch at once, spread over the workers
+            JobSystem::ParallelFor(count, BULK_INERTIA_GRAIN, [&](int begin, int end) {
+                for (int i = begin; i < end; i++) bodies[first + i].ComputeInertia();
+            });
+            addedAny = true;
+            return;
         }
+        if (command.type == CommandType::RemoveBodies) {
+            for (BodyHandle handle : command.handles) {
+                if (RigidBody* body = find(handle)) {
+                    markRemoved((int)(body - bodies.data()));
+                    indexOf.erase(handle);
+                }
+            }
+            return;
+        }
+        if (command.type == CommandType::RemoveAll) {
+            for (int i = 0; i < (int)bodies.size(); i++) markRemoved(i);
+            indexOf.clear();
+            indexed = true;
+            // Handles may start over after this, so no entry may outlive its bodies
+            pairCache.Clear();
+            return;
+        }
+
+        RigidBody* body = find(command.body);
+        if (!body) return;  // Already removed, or never added
+        switch (command.type) {
+        case CommandType::RemoveBody:
+            markRemoved((int)(body - bodies.data()));
+            indexOf.erase(command.body);
+            break;
+        case CommandType::ApplyImpulse:
+            if (body->isStatic || body->mass <= 0.0f) break;
+            body->velocity += command.vector / body->mass;
+            if (command.atPoint) {
+                glm::mat3 rot = glm::mat3_cast(body->orientation);
+                glm::mat3 worldInvInertia = rot * body->inverseInertiaTensor * glm::transpose(rot);
+                body->angularVelocity += worldInvInertia * glm::cross(command.point - body->position, command.vector);
+            }
+            body->isSleeping = false;
+            body->sleepCounter = 0;
+            break;
+        case CommandType::SetTransform:
+            body->position = command.vector;
+            body->orientation = command.orientation;
+            body->isSleeping = false;
+            body->sleepCounter = 0;
+            transforms.Invalidate((int)(body - bodies.data()));  // Static bodies keep a frozen slot
+            break;
+        case CommandType::CarveVoxels: {
+            if (body->GetShapeType() != ShapeType::VoxelWorld) break;
+            // Re-merged by ApplyVoxelEdits, which runs right after
+            VoxelWorld& world = *body->AsVoxelWorld().world;
+            int r = command.radius;
+            for (int z = -r; z <= r; z++) {
+                for (int y = -r; y <= r; y++) {
+                    for (int x = -r; x <= r; x++) {
+                        if (x * x + y * y + z * z <= r * r) world.SetVoxel(command.voxel + glm::ivec3(x, y, z), false);
+                    }
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    };
+    if (deterministic) commands.DrainByHandle(apply);
+    else commands.Drain(apply);
+
+    if (removedAny) {
+        // Compact in place from the first removal on, so removing a few bodies
+        // leaves the rest of the array (and its cached transforms) untouched.
+        // RigidBody can't be assigned (const members), so survivors are
+        // moved by destroy and re-construct.
+        removed.resize(bodies.size(), 0);
+        int kept = (int)(std::find(removed.begin(), removed.end(), 1) - removed.begin());
+        for (int i = kept; i < (int)bodies.size(); i++) {
+            if (removed[i]) {
+                voxelSnapshots.erase(bodies[i].id);
+                continue;
+            }
+            std::destroy_at(&bodies[kept]);
+            std::construct_at(&bodies[kept], std::move(bodies[i]));
+            kept++;
+        }
+        while ((int)bodies.size() > kept) bodies.pop_back();
+        transforms.Compact(removed);
     }
+    // Bodies may have moved in memory, so last step's manifolds point at garbage
+    if (removedAny || addedAny) {
+        lastFrameManifolds.clear();
+        bodySetVersion = ++lastBodySetVersion;
+    }
+}
 
-    std::cout << "====================[ End StepPhysics ]====================\n";
+void Scene::SaveState(uint64_t frame) {
+    // The only allocation once the ring is warm, and only after adds or removals
+    if (!savedBodySet || savedBodySetVersion != bodySetVersion) {
+        savedBodySet = std::make_shared<const std::vector<RigidBody>>(bodies);
+        savedBodySetVersion = bodySetVersion;
+    }
+
+    SavedState& state = savedStates.SlotFor(frame);
+    state.bodySetVersion = bodySetVersion;
+    state.bodySet = savedBodySet;
+    state.bodies.resize(bodies.size());
+    for (int i = 0; i < (int)bodies.size(); i++) {
+        const RigidBody& body = bodies[i];
+        state.bodies[i] = {body.id, body.isSleeping, body.hasAwakened, body.sleepCounter,
+                           body.position, body.velocity, body.forces, body.angularVelocity,
+                           body.torque, body.orientation, body.color};
+    }
+    pairCache.Save(state.pairs);
+    state.nextHandle = commands.NextHandle();
+    state.stateHash = LastStateHash();
 }
 
-void Scene::Render(Renderer& renderer, Shader& shader) {
-    for (RigidBody& body : bodies) {
-        glm::vec3 size = body.shape ? body.shape->GetSize() : glm::vec3(1.0f);  // FIXED HERE
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), body.position);
-        model = glm::scale(model, size);
-        model *= glm::toMat4(body.orientation); // Add rotation
-        glm::vec3 renderColor = (!body.hasAwakened)
+bool Scene::RestoreState(uint64_t frame) {
+    const SavedState* state = savedStates.Find(frame);
+    if (!state) return false;
+
+    bool rebuilt = state->bodySetVersion != bodySetVersion;
+    if (rebuilt) {
+        // Bodies came or went since; go back to that step's set, shapes and all.
+        // Can't assign RigidBody, so rebuild the vector.
+        bodies.clear();
+        bodies.reserve(state->bodySet->size());
+        for (const RigidBody& body : *state->bodySet) bodies.push_back(body);
+        bodySetVersion = state->bodySetVersion;
+        savedBodySet = state->bodySet;
+        savedBodySetVersion = bodySetVersion;
+        lastFrameManifolds.clear();
+    }
+
+    for (int i = 0; i < (int)bodies.size(); i++) {
+        RigidBody& body = bodies[i];
+        const BodyState& saved = state->bodies[i];
+        // A frozen transform slot is only right for the pose it was taken at
+        if (rebuilt || body.position != saved.position || body.orientation != saved.orientation) {
+            transforms.Invalidate(i);
+        }
+        body.isSleeping = saved.isSleeping;
+        body.hasAwakened = saved.hasAwakened;
+        body.sleepCounter = saved.sleepCounter;
+        body.position = saved.position;
+        body.velocity = saved.velocity;
+        body.forces = saved.forces;
+        body.angularVelocity = saved.angularVelocity;
+        body.torque = saved.torque;
+        body.orientation = saved.orientation;
+        body.color = saved.color;
+    }
+    pairCache.Restore(state->pairs);
+    commands.RestartHandles(state->nextHandle);
+    lastStateHash.store(state->stateHash, std::memory_order_release);
+    return true;
+}
+
+void Scene::ApplyVoxelEdits() {
+    std::vector<AABB> changed;
+    for (int i = 0; i < (int)bodies.size(); ++i) {
+        if (bodies[i].GetShapeType() != ShapeType::VoxelWorld) continue;
+        RigidBody& terrain = bodies[i];
+        changed.clear();
+        if (!terrain.AsVoxelWorld().world->RebuildDirtyChunks(changed)) continue;
+
+        terrain.size = terrain.AsVoxelWorld().GetSize();
+        transforms.Invalidate(i);
+        voxelSnapshots.erase(terrain.id);
+
+        // Bodies resting on edited chunks may have lost their support
+        glm::mat3 rot = glm::toMat3(terrain.orientation);
+        for (const AABB& region : changed) {
+            AABB worldRegion = BoxShape((region.max - region.min) * 0.5f)
+                                   .ComputeAABB(terrain.position + rot * ((region.min + region.max) * 0.5f), rot);
+            for (RigidBody& body : bodies) {
+                if (body.isStatic || !body.isSleeping || !body.GetAABB().Overlaps(worldRegion)) continue;
+                body.isSleeping = false;
+                body.sleepCounter = 0;
+            }
+        }
+    }
+}
+
+void Scene::AddPublishTasks(TaskGraph& graph, std::initializer_list<TaskGraph::TaskId> after) {
+    // All of these only read bodies, so they run side by side
+    graph.Add([this] { pairCache.Prune(); }, after);
+    TaskGraph::TaskId frozen = graph.Add([this] { FreezeVoxelWorlds(); }, after);
+    graph.Add([this] { PublishQuery(); }, {frozen});
+    graph.Add([this] { PublishRenderFrame(); }, {frozen});
+    graph.Add([this] { PublishPoses(); }, after);
+}
+
+void Scene::PublishStep() {
+    TaskGraph graph;
+    AddPublishTasks(graph, {});
+    graph.Run();
+}
+
+void Scene::PublishQuery() {
+    std::shared_ptr<const SceneQuery> snapshot = SceneQuery::Build(bodies, groundPlanes, voxelSnapshots);
+    std::lock_guard<std::mutex> lock(queryMutex);
+    query = std::move(snapshot);
+}
+
+void Scene::FreezeVoxelWorlds() {
+    for (const RigidBody& body : bodies) {
+        const VoxelWorldShape* voxels = std::get_if<VoxelWorldShape>(&body.shape);
+        if (!voxels) continue;
+        std::shared_ptr<VoxelWorld>& frozen = voxelSnapshots[body.id];
+        if (!frozen) frozen = std::make_shared<VoxelWorld>(*voxels->world);
+    }
+}
+
+void Scene::PublishRenderFrame() {
+    auto frame = std::make_shared<RenderFrame>();
+    frame->bodies.reserve(bodies.size());
+    for (const RigidBody& body : bodies) {
+        RenderBody draw{body.id, body.shape, body.position, body.orientation, body.color};
+        draw.color = (!body.hasAwakened)
             ? glm::vec3(0.7f)  // force gray before awake
             : (body.isSleeping ? body.color * 0.3f : body.color);
-        renderer.DrawCube(model, renderColor, shader);
+        if (body.GetShapeType() == ShapeType::VoxelWorld) draw.shape = VoxelWorldShape(voxelSnapshots.at(body.id));
+        frame->bodies.push_back(std::move(draw));
+    }
+    for (const RigidBody& ground : groundPlanes) {
+        frame->planes.push_back({ground.id, ground.shape, ground.position, ground.orientation, ground.color});
+    }
+
+    std::lock_guard<std::mutex> lock(frameMutex);
+    previousFrame = currentFrame ? currentFrame : frame;
+    currentFrame = std::move(frame);
+}
+
+void Scene::PublishPoses() {
+    uint64_t version = stepCount++;
+    PoseSnapshot* snapshot = poseBuffer.BeginWrite();
+    if (snapshot) snapshot->poses.clear();
+
+    // One serial pass in body order, so the hash never depends on threading.
+    // FNV-1a over 32-bit words of the exact float bits.
+    uint64_t hash = STATE_HASH_BASIS;
+    for (const RigidBody& body : bodies) {
+        BodyPose pose{body.id, body.position, body.orientation,
+                      body.velocity, body.angularVelocity, body.isSleeping};
+        uint32_t words[15] = {pose.id, (uint32_t)pose.isSleeping};
+        std::memcpy(words + 2, &pose.position, sizeof(glm::vec3));
+        std::memcpy(words + 5, &pose.orientation, sizeof(glm::quat));
+        std::memcpy(words + 9, &pose.velocity, sizeof(glm::vec3));
+        std::memcpy(words + 12, &pose.angularVelocity, sizeof(glm::vec3));
+        for (uint32_t word : words) hash = (hash ^ word) * STATE_HASH_PRIME;
+        if (snapshot) snapshot->poses.push_back(pose);
+    }
+    lastStateHash.store(hash, std::memory_order_release);
+
+    if (!snapshot) {
+        // Readers are holding every spare slot; they keep the last poses
+        std::cout << "⚠️ Pose snapshot skipped, all slots in use\n";
+        return;
+    }
+    snapshot->version = version;
+    snapshot->stateHash = hash;
+    poseBuffer.EndWrite();
+}
+
+std::shared_ptr<const SceneQuery> Scene::GetQuery() const {
+    std::lock_guard<std::mutex> lock(queryMutex);
+    return query;
+}
+
+void Scene::IntegratePositions(RigidBody& body, float dt) {
+    if (body.isStatic || body.isSleeping) return;
+
+    // NOW integrate positions with the corrected velocities
+    body.IntegratePosition(dt);
+    body.IntegrateOrientation(dt);
+
+    // Sleep/wake logic
+    float velSq = glm::length2(body.velocity);
+    float angVelSq = glm::length2(body.angularVelocity);
+    const float velTol = 0.0001f;
+    const float angVelTol = 0.0001f;
+
+    if (!body.hasAwakened && (velSq > 0.001f || angVelSq > 0.001f)) {
+        body.hasAwakened = true;
+        // Islands integrate in parallel, so no shared generator here
+        body.color = glm::vec3(0.2f) + 0.8f * RigidBody::StableColor(body.id, colorSeed);
+    }
+
+    if (velSq < velTol && angVelSq < angVelTol) {
+        body.sleepCounter++;
+        if (body.sleepCounter > body.sleepCounterThreshold) {
+            body.isSleeping = true;
+            body.velocity = glm::vec3(0.0f);
+            body.angularVelocity = glm::vec3(0.0f);
+            std::cout << "💤 Body sleeping\n";
+        }
+    } else {
+        body.sleepCounter = 0;
+    }
+}
+
+void Scene::Render(Renderer& renderer, Shader& shader, float alpha) {
+    std::shared_ptr<const RenderFrame> previous, current;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        previous = previousFrame;
+        current = currentFrame;
+    }
+
+    for (const RenderBody& ground : current->planes) {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), ground.position);
+        model *= glm::toMat4(glm::rotation(glm::vec3(0.0f, 1.0f, 0.0f), std::get<PlaneShape>(ground.shape).normal));
+        renderer.DrawPlane(model, shader);
+    }
+
+    // A body keeps its index until something is removed, which compacts the
+    // array. Only then look bodies up by id; ids aren't sorted, since a body
+    // built early can be posted after later ones.
+    std::unordered_map<uint32_t, size_t> previousIndex;
+    auto findPrevious = [&](size_t i, uint32_t id) -> const RenderBody* {
+        if (i < previous->bodies.size() && previous->bodies[i].id == id) return &previous->bodies[i];
+        if (previousIndex.empty()) {
+            for (size_t k = 0; k < previous->bodies.size(); k++) previousIndex.emplace(previous->bodies[k].id, k);
+        }
+        auto it = previousIndex.find(id);
+        return it != previousIndex.end() ? &previous->bodies[it->second] : nullptr;
+    };
+
+    for (size_t i = 0; i < current->bodies.size(); i++) {
+        const RenderBody& body = current->bodies[i];
+        glm::vec3 position = body.position;
+        glm::quat orientation = body.orientation;
+        if (const RenderBody* last = findPrevious(i, body.id)) {
+            position = glm::mix(last->position, body.position, alpha);
+            orientation = glm::slerp(last->orientation, body.orientation, alpha);
+        }
+        ShapeType type = static_cast<ShapeType>(body.shape.index());
+
+        glm::vec3 size = std::visit([](const auto& s) { return s.GetSize(); }, body.shape);
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+        model = glm::scale(model, size);
+        model *= glm::toMat4(orientation); // Add rotation
+        glm::vec3 renderColor = body.color;
+        if (type == ShapeType::Sphere) {
+            renderer.DrawSphere(model, renderColor, shader);
+        } else if (type == ShapeType::Capsule) {
+            // Stretched sphere along the capsule's own axis, close enough for debug drawing
+            glm::mat4 capsuleModel = glm::translate(glm::mat4(1.0f), position);
+            capsuleModel *= glm::toMat4(orientation);
+            capsuleModel = glm::scale(capsuleModel, size);
+            renderer.DrawSphere(capsuleModel, renderColor, shader);
+        } else if (type == ShapeType::ConvexHull) {
+            glm::mat4 hullModel = glm::translate(glm::mat4(1.0f), position);
+            hullModel *= glm::toMat4(orientation);
+            renderer.DrawHull(*std::get<ConvexHullShape>(body.shape).hull, hullModel, renderColor, shader);
+        } else if (type == ShapeType::TriangleMesh) {
+            glm::mat4 meshModel = glm::translate(glm::mat4(1.0f), position);
+            meshModel *= glm::toMat4(orientation);
+            renderer.DrawMesh(*std::get<TriangleMeshShape>(body.shape).mesh, meshModel, renderColor, shader);
+        } else if (type == ShapeType::Heightfield) {
+            glm::mat4 fieldModel = glm::translate(glm::mat4(1.0f), position);
+            fieldModel *= glm::toMat4(orientation);
+            renderer.DrawHeightfield(*std::get<HeightfieldShape>(body.shape).field, fieldModel, renderColor, shader);
+        } else if (type == ShapeType::Compound) {
+            glm::mat4 bodyModel = glm::translate(glm::mat4(1.0f), position);
+            bodyModel *= glm::toMat4(orientation);
+            for (const CompoundChild& child : std::get<CompoundShape>(body.shape).compound->children) {
+                glm::mat4 childModel = glm::translate(bodyModel, child.position) * glm::toMat4(child.orientation);
+                if (const ConvexHullShape* hull = std::get_if<ConvexHullShape>(&child.shape)) {
+                    renderer.DrawHull(*hull->hull, childModel, renderColor, shader);
+                    continue;
+                }
+                glm::vec3 childSize = std::visit([](const auto& s) { return s.GetSize(); }, child.shape);
+                if (std::holds_alternative<BoxShape>(child.shape)) {
+                    renderer.DrawCube(glm::scale(childModel, childSize), renderColor, shader);
+                } else {
+                    renderer.DrawSphere(glm::scale(childModel, childSize), renderColor, shader);
+                }
+            }
+        } else if (type == ShapeType::VoxelWorld) {
+            // One cube per merged box, so the merge is visible too
+            glm::mat4 worldModel = glm::translate(glm::mat4(1.0f), position);
+            worldModel *= glm::toMat4(orientation);
+            for (const auto& [key, chunk] : std::get<VoxelWorldShape>(body.shape).world->chunks) {
+                for (const VoxelBox& box : chunk.boxes) {
+                    glm::mat4 boxModel = glm::translate(worldModel, box.center);
+                    boxModel = glm::scale(boxModel, box.halfExtents * 2.0f);
+                    renderer.DrawCube(boxModel, renderColor, shader);
+                }
+            }
+        } else {
+            renderer.DrawCube(model, renderColor, shader);
+        }
     }
 }
 
@@ -158,17 +656,46 @@ void Scene::RenderDebug(Renderer& renderer, const glm::mat4& viewProj) {
     }
 }
 
+void Scene::SpawnTestBox() {
+    glm::vec3 fullSize(1.0f);
+    glm::vec3 startPos = glm::vec3(0.0f, 0.0f, 0.0f);  // On floor
+
+    RigidBody box(1.0f, startPos, fullSize);
+    box.SetShapeAndSize(fullSize);
+    box.hasAwakened = false;
+    commands.AddBody(box);
+    std::cout << "🚀 Spawned test box at " << glm::to_string(startPos) << "\n";
+}
+
 void Scene::HandleInput(GLFWwindow* window) {
     static bool spacePressedLastFrame = false;
     static bool rPressedLastFrame = false;
+    static bool fPressedLastFrame = false;
+    static bool gPressedLastFrame = false;
+    static bool hPressedLastFrame = false;
+    static bool mPressedLastFrame = false;
+    static bool tPressedLastFrame = false;
+    static bool vPressedLastFrame = false;
+    static bool cPressedLastFrame = false;
 
     bool spacePressed = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
     bool rPressed = glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS;
+    bool fPressed = glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS;
+    bool gPressed = glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS;
+    bool hPressed = glfwGetKey(window, GLFW_KEY_H) == GLFW_PRESS;
+    bool mPressed = glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS;
+    bool tPressed = glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS;
+    bool vPressed = glfwGetKey(window, GLFW_KEY_V) == GLFW_PRESS;
+    bool cPressed = glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS;
+
+    // Input may run while a step is in progress, so it reads the last
+    // published snapshot and posts edits instead of touching bodies
+    std::shared_ptr<const SceneQuery> snapshot = GetQuery();
 
     if (spacePressed && !spacePressedLastFrame) {
         float x = ((rand() % 200) - 100) / 50.0f;
         float z = ((rand() % 200) - 100) / 50.0f;
-        float y = 6.0f + (float)bodies.size() * 1.2f;
+        float y = 6.0f + (float)snapshot->Bodies().size() * 1.2f;
 
         glm::vec3 fullSize(1.0f);
         glm::vec3 halfExtents = fullSize * 0.5f;
@@ -176,42 +703,185 @@ void Scene::HandleInput(GLFWwindow* window) {
         RigidBody box(1.0f, glm::vec3(x, y, z), fullSize);
         box.SetShapeAndSize(fullSize);
         box.hasAwakened = false;
-        bodies.push_back(box);
+        commands.AddBody(box);
     }
 
-    if (rPressed && !rPressedLastFrame) {
-        bodies.clear();
+    if (fPressed && !fPressedLastFrame) {
+        float x = ((rand() % 200) - 100) / 50.0f;
+        float z = ((rand() % 200) - 100) / 50.0f;
+        float y = 6.0f + (float)snapshot->Bodies().size() * 1.2f;
 
-        RigidBody floor(0.0f, glm::vec3(0.0f, -1.0f, 0.0f));
-        floor.size = glm::vec3(40.0f, 2.0f, 40.0f);
-        floor.shape = std::make_shared<BoxShape>(floor.size * 0.5f);
-        floor.color = glm::vec3(0.3f, 0.8f, 0.3f);
-        floor.isStatic = true;
-        floor.velocity = glm::vec3(0.0f);
-        floor.orientation = glm::quat(1, 0, 0, 0);              // 🔒 Lock rotation
-        floor.angularVelocity = glm::vec3(0.0f);                // 🔒 No angular motion
-        floor.inverseInertiaTensor = glm::mat3(0.0f);           // 🔒 No rotatione
-        floor.staticFriction = 0.9f;
-        floor.dynamicFriction = 0.8f;
-        floor.hasAwakened = true;
-        bodies.push_back(floor);
-    }
-
-    if (bodies.size() == 1) {  // If only floor exists
-        glm::vec3 fullSize(1.0f);
-        glm::vec3 halfExtents = fullSize * 0.5f;
-        glm::vec3 startPos = glm::vec3(0.0f, 0.0f, 0.0f);  // On floor
+        RigidBody ball(1.0f, glm::vec3(x, y, z));
+        ball.SetSphere(0.5f);
+        ball.hasAwakened = false;
+        commands.AddBody(ball);
+    }
 
-        RigidBody box(1.0f, startPos, fullSize);
-        box.shape = std::make_shared<BoxShape>(halfExtents);
-        box.hasAwakened = false;
-        bodies.push_back(box);
-        std::cout << "🚀 Spawned test box at " << glm::to_string(startPos) << "\n";
+    if (gPressed && !gPressedLastFrame) {
+        float x = ((rand() % 200) - 100) / 50.0f;
+        float z = ((rand() % 200) - 100) / 50.0f;
+        float y = 6.0f + (float)snapshot->Bodies().size() * 1.2f;
+
+        RigidBody capsule(1.0f, glm::vec3(x, y, z));
+        capsule.SetCapsule(0.3f, 0.4f);
+        capsule.orientation = glm::angleAxis(glm::radians(80.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        capsule.hasAwakened = false;
+        commands.AddBody(capsule);
     }
 
+    if (hPressed && !hPressedLastFrame) {
+        // Every rock shares one hull, built from a random cloud the first time
+        std::vector<glm::vec3> cloud;
+        if (!ShapeRegistry::FindHull("rock")) {
+            for (int i = 0; i < 24; i++) {
+                glm::vec3 p(((rand() % 200) - 100) / 100.0f, ((rand() % 200) - 100) / 100.0f, ((rand() % 200) - 100) / 100.0f);
+                if (glm::length(p) > 0.01f) cloud.push_back(glm::normalize(p) * glm::vec3(0.7f, 0.45f, 0.55f));
+            }
+        }
+        std::shared_ptr<const HullData> rock = ShapeRegistry::RegisterHull("rock", cloud);
+
+        if (rock) {
+            float x = ((rand() % 200) - 100) / 50.0f;
+            float z = ((rand() % 200) - 100) / 50.0f;
+            float y = 6.0f + (float)snapshot->Bodies().size() * 1.2f;
+
+            RigidBody debris(1.0f, glm::vec3(x, y, z));
+            debris.SetConvexHull(rock);
+            debris.hasAwakened = false;
+            commands.AddBody(debris);
+        }
+    }
+
+    if (mPressed && !mPressedLastFrame) {
+        // Bumpy static terrain patch, built once and shared
+        std::shared_ptr<const MeshData> terrain = ShapeRegistry::FindMesh("terrain");
+        if (!terrain) {
+            const int cells = 32;
+            const float extent = 12.0f;
+            std::vector<glm::vec3> vertices;
+            std::vector<uint32_t> indices;
+            for (int z = 0; z <= cells; z++) {
+                for (int x = 0; x <= cells; x++) {
+                    float px = (x / (float)cells - 0.5f) * extent;
+                    float pz = (z / (float)cells - 0.5f) * extent;
+                    float py = 0.3f + 0.3f * std::sin(px * 0.8f) * std::cos(pz * 0.6f);
+                    vertices.push_back(glm::vec3(px, py, pz));
+                }
+            }
+            for (int z = 0; z < cells; z++) {
+                for (int x = 0; x < cells; x++) {
+                    uint32_t i0 = z * (cells + 1) + x;
+                    uint32_t i1 = i0 + 1;
+                    uint32_t i2 = i0 + (cells + 1);
+                    uint32_t i3 = i2 + 1;
+                    indices.insert(indices.end(), {i0, i2, i1, i1, i2, i3});
+                }
+            }
+            terrain = ShapeRegistry::RegisterMesh("terrain", vertices, indices);
+        }
+
+        if (terrain) {
+            RigidBody level(0.0f, glm::vec3(0.0f));
+            level.SetTriangleMesh(terrain);
+            level.color = glm::vec3(0.45f, 0.4f, 0.3f);
+            level.hasAwakened = true;
+            commands.AddBody(level);
+        }
+    }
+
+    if (tPressed && !tPressedLastFrame) {
+        // Rolling hills; a 256x256 grid costs a quarter megabyte of heights
+        std::shared_ptr<const HeightfieldData> hills = ShapeRegistry::FindHeightfield("hills");
+        if (!hills) {
+            const int samples = 257;
+            const float cellSize = 0.25f;
+            std::vector<float> heights(samples * samples);
+            for (int z = 0; z < samples; z++) {
+                for (int x = 0; x < samples; x++) {
+                    float px = (x - samples / 2) * cellSize;
+                    float pz = (z - samples / 2) * cellSize;
+                    heights[z * samples + x] = 0.5f + 0.5f * std::sin(px * 0.3f) * std::cos(pz * 0.25f);
+                }
+            }
+            hills = ShapeRegistry::RegisterHeightfield("hills", samples, samples, cellSize, heights);
+        }
+
+        if (hills) {
+            RigidBody terrain(0.0f, glm::vec3(0.0f));
+            terrain.SetHeightfield(hills);
+            terrain.color = glm::vec3(0.35f, 0.5f, 0.3f);
+            terrain.hasAwakened = true;
+            commands.AddBody(terrain);
+        }
+    }
+
+    if (cPressed && !cPressedLastFrame) {
+        // Table: one top and four legs, a single broadphase entry
+        std::shared_ptr<const CompoundData> table = ShapeRegistry::FindCompound("table");
+        if (!table) {
+            std::vector<CompoundChild> parts;
+            parts.push_back({BoxShape(glm::vec3(0.8f, 0.05f, 0.5f)), glm::vec3(0.0f, 0.45f, 0.0f)});
+            for (int x = -1; x <= 1; x += 2) {
+                for (int z = -1; z <= 1; z += 2) {
+                    parts.push_back({BoxShape(glm::vec3(0.05f, 0.4f, 0.05f)), glm::vec3(x * 0.7f, 0.0f, z * 0.4f)});
+                }
+            }
+            table = ShapeRegistry::RegisterCompound("table", std::move(parts));
+        }
+
+        if (table) {
+            float x = ((rand() % 200) - 100) / 50.0f;
+            float z = ((rand() % 200) - 100) / 50.0f;
+            float y = 6.0f + (float)snapshot->Bodies().size() * 1.2f;
+
+            RigidBody prop(2.0f, glm::vec3(x, y, z));
+            prop.SetCompound(table);
+            prop.hasAwakened = false;
+            commands.AddBody(prop);
+        }
+    }
+
+    if (vPressed && !vPressedLastFrame) {
+        auto terrain = std::find_if(snapshot->Bodies().begin(), snapshot->Bodies().end(), [](const QueryBody& body) {
+            return std::holds_alternative<VoxelWorldShape>(body.shape);
+        });
+
+        if (terrain == snapshot->Bodies().end()) {
+            // Terraced hill, 48 x 48 voxels of 0.5 m
+            auto world = std::make_shared<VoxelWorld>(0.5f);
+            for (int z = -24; z < 24; z++) {
+                for (int x = -24; x < 24; x++) {
+                    int height = 1 + (int)(3.0f * std::exp(-(x * x + z * z) / 200.0f));
+                    for (int y = 0; y < height; y++) world->SetVoxel(glm::ivec3(x, y, z), true);
+                }
+            }
+
+            RigidBody voxels(0.0f, glm::vec3(0.0f));
+            voxels.SetVoxelWorld(world);
+            voxels.color = glm::vec3(0.55f, 0.45f, 0.35f);
+            voxels.hasAwakened = true;
+            commands.AddBody(voxels);
+        } else {
+            // Dig a crater; only the chunks it touches get re-merged next step
+            glm::ivec3 center((rand() % 40) - 20, 2, (rand() % 40) - 20);
+            commands.CarveVoxels(terrain->id, center, 3);
+        }
+    }
+
+    if (rPressed && !rPressedLastFrame) {
+        commands.RemoveAll();  // Ground planes live outside `bodies` and survive a reset
+        SpawnTestBox();
+    }
 
     spacePressedLastFrame = spacePressed;
     rPressedLastFrame = rPressed;
+    fPressedLastFrame = fPressed;
+    gPressedLastFrame = gPressed;
+    hPressedLastFrame = hPressed;
+    mPressedLastFrame = mPressed;
+    tPressedLastFrame = tPressed;
+    vPressedLastFrame = vPressed;
+    cPressedLastFrame = cPressed;
 }
 
 // Add this method to your Scene class
@@ -228,10 +898,9 @@ void Scene::StepPhysicsWithSubdivision(float dt) {
 
     // If objects are moving too fast, subdivide the timestep
     int subdivisions = 1;
-    const float maxSafeSpeed = 3.0f; // Lower threshold for better collision detection
-    if (maxSpeed > maxSafeSpeed) {
-        subdivisions = static_cast<int>(std::ceil(maxSpeed / maxSafeSpeed));
-        subdivisions = std::min(subdivisions, 8); // Increase max subdivisions
+    if (maxSpeed > MAX_SAFE_SPEED) {
+        subdivisions = static_cast<int>(std::ceil(maxSpeed / MAX_SAFE_SPEED));
+        subdivisions = std::min(subdivisions, MAX_SUBSTEPS); // Increase max subdivisions
         std::cout << "⚡ Fast motion detected (" << maxSpeed << " m/s), using "
                   << subdivisions << " subdivisions\n";
     }
@@ -242,6 +911,330 @@ void Scene::StepPhysicsWithSubdivision(float dt) {
     }
 }
 
+// Per-island alternative to StepPhysicsWithSubdivision: calm islands take one
+// step while an island with a fast body is subdivided on its own.
+void Scene::StepPhysicsWithIslands(float dt) {
+    dt = std::clamp(dt, 0.001f, 0.016f);
+
+    // Edits change the body array itself, so they finish before any task starts
+    ApplyCommands();
+    pairCache.BeginFrame();
+    ApplyVoxelEdits();
+
+    std::vector<AABB> sweptAABBs;
+    std::vector<int> dynamicBodies, staticBodies;
+    std::vector<BodyPair> dynamicPairs, staticPairs, pairs;
+    std::vector<Island> islands;
+    std::vector<int> islandOfBody;
+    std::vector<std::vector<ContactManifold>> islandManifolds;
+
+    TaskGraph graph;
+    TaskGraph::TaskId moved = graph.Add([&] { transforms.Update(bodies); });
+    // Broadphase once per frame, shared by every substep of every island
+    TaskGraph::TaskId swept = graph.Add([&] {
+        ComputeSweptAABBs(dt, sweptAABBs);
+        for (int i = 0; i < (int)bodies.size(); ++i) {
+            (bodies[i].isStatic ? staticBodies : dynamicBodies).push_back(i);
+        }
+    }, {moved});
+    // Islands only need the dynamic pairs, so grouping starts while the
+    // static side is still sweeping; static-static pairs are never looked for
+    TaskGraph::TaskId dynamicPaired = graph.Add([&] {
+        Broadphase::FindPairs(sweptAABBs, dynamicBodies, dynamicPairs);
+    }, {swept});
+    TaskGraph::TaskId staticPaired = graph.Add([&] {
+        Broadphase::FindPairsBetween(sweptAABBs, dynamicBodies, staticBodies, staticPairs);
+    }, {swept});
+    TaskGraph::TaskId grouped = graph.Add([&] {
+        IslandBuilder::Group(bodies, dynamicPairs, islands, islandOfBody);
+    }, {dynamicPaired});
+    TaskGraph::TaskId paired = graph.Add([&] {
+        pairs.resize(dynamicPairs.size() + staticPairs.size());
+        std::merge(dynamicPairs.begin(), dynamicPairs.end(), staticPairs.begin(), staticPairs.end(), pairs.begin(),
+                   [](const BodyPair& l, const BodyPair& r) { return l.a != r.a ? l.a < r.a : l.b < r.b; });
+    }, {dynamicPaired, staticPaired});
+    TaskGraph::TaskId attached = graph.Add([&] {
+        IslandBuilder::AssignPairs(bodies, pairs, islandOfBody, islands);
+    }, {grouped, paired});
+    // Entries made up front, so islands only look up their own pairs' slots
+    TaskGraph::TaskId cached = graph.Add([&] {
+        for (const BodyPair& pair : pairs) pairCache.Get(bodies[pair.a].id, bodies[pair.b].id);
+    }, {paired});
+
+    // Islands share no dynamic bodies and no pair cache entries, so each runs
+    // its narrowphase straight into its own solve while others are still detecting
+    TaskGraph::TaskId solved = graph.Add([&] {
+        islandManifolds.resize(islands.size());
+        JobSystem::ParallelFor((int)islands.size(), 1, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) StepIsland(islands[i], dt, islandManifolds[i]);
+        });
+    }, {attached, cached});
+
+    // Merged in island order, so the result doesn't depend on scheduling
+    graph.Add([&] {
+        lastFrameManifolds.clear();
+        for (std::vector<ContactManifold>& manifolds : islandManifolds) {
+            lastFrameManifolds.insert(lastFrameManifolds.end(), manifolds.begin(), manifolds.end());
+        }
+    }, {solved});
+    AddPublishTasks(graph, {solved});
+    graph.Run();
+}
+
+void Scene::StepIsland(const Island& island, float dt, std::vector<ContactManifold>& manifolds) {
+    if (island.isSleeping) return;
+
+    int substeps = ComputeIslandSubsteps(island, dt);
+    if (substeps > 1) {
+        std::cout << "⚡ Island of " << island.bodies.size() << " bodies using "
+                  << substeps << " substeps\n";
+    }
+
+    // Narrowphase once for the island, then cheap substeps
+    std::vector<ContactConstraint> constraints;
+    std::vector<BodyPair> pendingPairs;
+    PrepareContacts(island.pairs, constraints, pendingPairs, manifolds);
+
+    float subDt = dt / substeps;
+    for (int i = 0; i < substeps; i++) {
+        if (i > 0) transforms.Update(bodies, island.bodies);
+        SolveSubstep(island.bodies, constraints, pendingPairs, subDt);
+    }
+}
+
+// Fixed-count substepping that pays for broadphase and narrowphase once per
+// frame. Cheap enough to run routinely for stacking stability.
+void Scene::StepPhysicsWithSubsteps(float dt, int substeps) {
+    dt = std::clamp(dt, 0.001f, 0.016f);
+    substeps = std::clamp(substeps, 1, MAX_SUBSTEPS);
+
+    ApplyCommands();
+    pairCache.BeginFrame();
+    ApplyVoxelEdits();
+    transforms.Update(bodies);
+    std::vector<BodyPair> pairs;
+    FindSweptPairs(dt, pairs);
+
+    std::vector<int> bodyIndices(bodies.size());
+    std::iota(bodyIndices.begin(), bodyIndices.end(), 0);
+
+    std::vector<ContactConstraint> constraints;
+    std::vector<BodyPair> pendingPairs;
+    lastFrameManifolds.clear();
+    PrepareContacts(pairs, constraints, pendingPairs, lastFrameManifolds);
+
+    float subDt = dt / substeps;
+    for (int i = 0; i < substeps; i++) {
+        if (i > 0) transforms.Update(bodies);
+        SolveSubstep(bodyIndices, constraints, pendingPairs, subDt);
+    }
+
+    PublishStep();
+}
+
+ContactManifold Scene::DetectPair(int i, int j) {
+    return CollisionDispatch::Detect(bodies[i], transforms.rotations[i], bodies[j], transforms.rotations[j], pairCache);
+}
+
+void Scene::FindSweptPairs(float dt, std::vector<BodyPair>& pairs) {
+    std::vector<AABB> sweptAABBs;
+    ComputeSweptAABBs(dt, sweptAABBs);
+    Broadphase::FindPairs(sweptAABBs, pairs);
+}
+
+void Scene::ComputeSweptAABBs(float dt, std::vector<AABB>& sweptAABBs) {
+    // AABBs swept over the whole frame, so the pairs stay valid for every substep
+    sweptAABBs.resize(bodies.size());
+    JobSystem::ParallelFor((int)bodies.size(), SWEPT_AABB_GRAIN, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const RigidBody& body = bodies[i];
+            if (body.isStatic || body.isSleeping) {
+                sweptAABBs[i] = transforms.worldAABBs[i];
+            } else {
+                sweptAABBs[i] = Broadphase::ExpandByVelocity(transforms.worldAABBs[i], body.velocity, dt, BROADPHASE_MARGIN);
+            }
+        }
+    });
+}
+
+int Scene::ComputeIslandSubsteps(const Island& island, float dt) const {
+    float maxSpeed = 0.0f;
+    float minDimension = std::numeric_limits<float>::max();
+    for (int index : island.bodies) {
+        const RigidBody& body = bodies[index];
+        if (body.isSleeping) continue;
+        maxSpeed = std::max(maxSpeed, glm::length(body.velocity));
+        minDimension = std::min({minDimension, body.size.x, body.size.y, body.size.z});
+    }
+
+    int substeps = 1;
+    if (maxSpeed > MAX_SAFE_SPEED) {
+        substeps = static_cast<int>(std::ceil(maxSpeed / MAX_SAFE_SPEED));
+    }
+
+    // Same rule as WouldTunnel: never move more than half the smallest body per substep
+    float distanceThisFrame = maxSpeed * dt;
+    if (minDimension > 0.0f && distanceThisFrame > minDimension * 0.5f) {
+        substeps = std::max(substeps, static_cast<int>(std::ceil(distanceThisFrame / (minDimension * 0.5f))));
+    }
+
+    return std::min(substeps, MAX_SUBSTEPS);
+}
+
+void Scene::PrepareContacts(const std::vector<BodyPair>& pairs,
+                            std::vector<ContactConstraint>& constraints,
+                            std::vector<BodyPair>& pendingPairs,
+                            std::vector<ContactManifold>& manifolds) {
+    // Not touching yet, but the swept AABBs say it may happen this frame
+    DetectPairs(pairs, manifolds, &pendingPairs, &constraints);
+}
+
+void Scene::DetectPairs(const std::vector<BodyPair>& pairs,
+                        std::vector<ContactManifold>& manifolds,
+                        std::vector<BodyPair>* separatedPairs,
+                        std::vector<ContactConstraint>* constraints) {
+    // Entries made here, so workers only look up the slot of their own pair
+    for (const BodyPair& pair : pairs) {
+        pairCache.Get(bodies[pair.a].id, bodies[pair.b].id);
+    }
+
+    auto shapePairKey = [&](const BodyPair& pair) {
+        return CollisionDispatch::PairKey(bodies[pair.a].GetShapeType(), bodies[pair.b].GetShapeType());
+    };
+
+    // Sort by shape pair so each run within a chunk uses a single narrowphase kernel
+    std::vector<BodyPair> sorted(pairs);
+    std::stable_sort(sorted.begin(), sorted.end(), [&](const BodyPair& l, const BodyPair& r) {
+        return shapePairKey(l) < shapePairKey(r);
+    });
+
+    // Every chunk of pairs writes only to its own buffers
+    struct ChunkOutput {
+        std::vector<ContactManifold> manifolds;
+        std::vector<BodyPair> separated;
+        std::vector<ContactConstraint> constraints;
+        std::vector<size_t> constraintsEnd;  // Per manifold
+    };
+    int chunkCount = (int)((sorted.size() + NARROWPHASE_GRAIN - 1) / NARROWPHASE_GRAIN);
+    std::vector<ChunkOutput> chunks(chunkCount);
+    JobSystem::ParallelFor(chunkCount, 1, [&](int firstChunk, int lastChunk) {
+        for (int c = firstChunk; c < lastChunk; c++) {
+            ChunkOutput& out = chunks[c];
+            size_t end = std::min(sorted.size(), (size_t)(c + 1) * NARROWPHASE_GRAIN);
+            for (size_t k = (size_t)c * NARROWPHASE_GRAIN; k < end;) {
+                uint32_t key = shapePairKey(sorted[k]);
+                NarrowphaseFn detect = CollisionDispatch::TABLE[key];
+                for (; k < end && shapePairKey(sorted[k]) == key; ++k) {
+                    const BodyPair& pair = sorted[k];
+                    ContactManifold m;
+                    if (transforms.worldAABBs[pair.a].Overlaps(transforms.worldAABBs[pair.b])) {
+                        m = detect(bodies[pair.a], transforms.rotations[pair.a],
+                                   bodies[pair.b], transforms.rotations[pair.b], pairCache);
+                    }
+                    if (!m.hasCollision) {
+                        out.separated.push_back(pair);
+                        continue;
+                    }
+                    // Constraints straight from the fresh manifold, while other chunks still detect
+                    if (constraints) {
+                        ContactConstraint::AppendFromManifold(m, out.constraints);
+                        out.constraintsEnd.push_back(out.constraints.size());
+                    }
+                    out.manifolds.push_back(std::move(m));
+                }
+            }
+        }
+    });
+
+    // Merge ordered by body ids, which are unique per pair, so the output is
+    // the same however the chunks were scheduled
+    auto idKey = [](uint32_t idA, uint32_t idB) {
+        return ((uint64_t)std::min(idA, idB) << 32) | std::max(idA, idB);
+    };
+    struct Hit {
+        uint64_t key;
+        int chunk;
+        int index;
+    };
+    std::vector<Hit> hits;
+    for (int c = 0; c < chunkCount; c++) {
+        for (int i = 0; i < (int)chunks[c].manifolds.size(); i++) {
+            const ContactManifold& m = chunks[c].manifolds[i];
+            hits.push_back({idKey(m.a->id, m.b->id), c, i});
+        }
+    }
+    std::sort(hits.begin(), hits.end(), [](const Hit& l, const Hit& r) { return l.key < r.key; });
+    manifolds.reserve(manifolds.size() + hits.size());
+    for (const Hit& hit : hits) {
+        ChunkOutput& chunk = chunks[hit.chunk];
+        manifolds.push_back(std::move(chunk.manifolds[hit.index]));
+        if (!constraints) continue;
+        size_t begin = hit.index > 0 ? chunk.constraintsEnd[hit.index - 1] : 0;
+        constraints->insert(constraints->end(), chunk.constraints.begin() + begin,
+                            chunk.constraints.begin() + chunk.constraintsEnd[hit.index]);
+    }
+
+    if (!separatedPairs) return;
+    size_t first = separatedPairs->size();
+    for (ChunkOutput& chunk : chunks) {
+        separatedPairs->insert(separatedPairs->end(), chunk.separated.begin(), chunk.separated.end());
+    }
+    std::sort(separatedPairs->begin() + first, separatedPairs->end(), [&](const BodyPair& l, const BodyPair& r) {
+        return idKey(bodies[l.a].id, bodies[l.b].id) < idKey(bodies[r.a].id, bodies[r.b].id);
+    });
+}
+
+void Scene::SolveSubstep(const std::vector<int>& bodyIndices,
+                         std::vector<ContactConstraint>& constraints,
+                         std::vector<BodyPair>& pendingPairs,
+                         float dt) {
+    for (int index : bodyIndices) {
+        IntegrateVelocities(index, dt);
+    }
+
+    // Existing contacts: only refresh separation from the new poses
+    for (ContactConstraint& c : constraints) {
+        c.Refresh(transforms.rotations[c.a - bodies.data()], transforms.rotations[c.b - bodies.data()]);
+        ResolveContact(*c.a, *c.b, c.point, c.normal, c.penetration, dt);
+    }
+
+    // Plane contacts are cheap enough to regenerate every substep
+    std::vector<ContactManifold> planeManifolds;
+    for (int index : bodyIndices) {
+        CollidePlanes(index, planeManifolds);
+    }
+    ResolveManifolds(planeManifolds, dt);
+
+    // Pairs that weren't touching at frame start get full narrowphase until they do
+    for (size_t i = 0; i < pendingPairs.size();) {
+        const BodyPair& pair = pendingPairs[i];
+
+        ContactManifold m;
+        if (transforms.worldAABBs[pair.a].Overlaps(transforms.worldAABBs[pair.b])) {
+            m = DetectPair(pair.a, pair.b);
+        }
+
+        if (!m.hasCollision) {
+            ++i;
+            continue;
+        }
+
+        size_t first = constraints.size();
+        ContactConstraint::AppendFromManifold(m, constraints);
+        for (size_t k = first; k < constraints.size(); ++k) {
+            ResolveContact(*constraints[k].a, *constraints[k].b, constraints[k].point,
+                           constraints[k].normal, constraints[k].penetration, dt);
+        }
+
+        pendingPairs[i] = pendingPairs.back();
+        pendingPairs.pop_back();
+    }
+
+    for (int index : bodyIndices) {
+        IntegratePositions(bodies[index], dt);
+    }
+}
+
 // Add this method to your Scene class to check for potential tunneling
 bool Scene::WouldTunnel(const RigidBody& body, float dt) {
     if (body.isStatic) return false;
@@ -1,30 +1,173 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <GLFW/glfw3.h>
+#include "CommandQueue.h"
+#include "PoseBuffer.h"
+#include "StateRing.h"
+#include "StepHandle.h"
+#include "TaskGraph.h"
 #include "physics/bodies/RigidBody.h"
 #include "graphics/Renderer.h"
 #include "graphics/Shader.h"
 #include "physics/collision/ContactSolver.h"
 #include "physics/collision/ContactManifold.h"
+#include "physics/collision/PairCache.h"
+#include "physics/collision/SceneQuery.h"
+#include "physics/bodies/TransformCache.h"
+#include "physics/dynamics/Island.h"
+#include "physics/dynamics/ContactConstraint.h"
+
+// What Render needs from one body, copied out after every step so drawing
+// never reads bodies while another thread is stepping them
+struct RenderBody {
+    uint32_t id;
+    Shape shape;  // Geometry is shared, not copied
+    glm::vec3 position;
+    glm::quat orientation;
+    glm::vec3 color;  // Already shaded for asleep / not yet woken
+};
+
+struct RenderFrame {
+    std::vector<RenderBody> bodies;
+    std::vector<RenderBody> planes;
+};
 
 class Scene {
 public:
     Scene();
+    ~Scene();  // Finishes any queued async steps first
     ContactSolver solver;
 
     void StepPhysics(float dt);
-    void Render(Renderer& renderer, Shader& shader);
+    // Draws the last two published steps blended by alpha (0 = previous, 1 = latest)
+    void Render(Renderer& renderer, Shader& shader, float alpha = 1.0f);
     void RenderDebug(Renderer& renderer, const glm::mat4& viewProj);
     void HandleInput(GLFWwindow* window);
     void StepPhysicsWithSubdivision(float dt);
+    void StepPhysicsWithIslands(float dt);
+    void StepPhysicsWithSubsteps(float dt, int substeps);
+    // Queues a StepPhysicsWithIslands on the scene's own stepping thread and
+    // returns straight away. Steps run one at a time in request order. While
+    // one is in flight:
+    //  - GetQuery, AcquirePoses and Render see the last completed step, never
+    //    a partial one; awaiting the handle gives this step's query snapshot
+    //  - Commands posted now apply at the start of the next step that hasn't
+    //    begun, which may be the one in flight
+    //  - nothing else may touch the scene: no synchronous Step* calls, and
+    //    no PhysicsThread on the same scene
+    StepHandle StepAsync(float dt);
     bool WouldTunnel(const RigidBody& body, float dt);
     void RenderContactPoints(Renderer& renderer, const glm::mat4& viewProj);
+    // World as of the last completed step; safe to keep and query from any thread
+    std::shared_ptr<const SceneQuery> GetQuery() const;
+    // Lockstep / replay mode: commands apply in handle order rather than
+    // posting order, and colors come from seed. Clears the scene and restarts
+    // handles from 0 on the next step. Results are then bit-identical across
+    // runs, scenes and thread counts for the same commands and time steps, as
+    // long as handles are taken in the same order (adds from one thread, or
+    // handles from ReserveHandles).
+    void SetDeterministic(uint64_t seed);
+    // 64-bit hash of every body's handle, pose, velocities and sleep state after
+    // the last completed step; compare across peers to catch a desync that frame
+    uint64_t LastStateHash() const { return lastStateHash.load(std::memory_order_acquire); }
+    // Rollback: SaveState copies the current step's bodies and pair cache
+    // into a ring slot for frame (your own frame number), RestoreState puts
+    // them back so the following steps replay with the same warm caches.
+    // Same threading rule as the Step* calls. Restoring rewinds adds,
+    // removals and the handle sequence too, but not voxel edits, pending
+    // commands or published snapshots; those catch up with the next step.
+    void SetRollbackWindow(int frames) { savedStates.Resize(frames); }
+    void SaveState(uint64_t frame);
+    bool RestoreState(uint64_t frame);  // False if frame fell out of the window
+    // Adds, removals and pushes from any thread, applied when the next step starts
+    CommandQueue& Commands() { return commands; }
+    // Latest body poses without locking; hold the reader only while using it
+    PoseBuffer::Reader AcquirePoses() const { return poseBuffer.Acquire(); }
 
 private:
     std::vector<RigidBody> bodies;
+    std::vector<RigidBody> groundPlanes;  // Static half-spaces, tested directly instead of via broadphase
     std::vector<ContactManifold> lastFrameManifolds;
+    PairCache pairCache;
+    TransformCache transforms;
+    std::shared_ptr<const SceneQuery> query;
+    mutable std::mutex queryMutex;  // Guards swapping the pointer, not the snapshot
+    // Double-buffered for render interpolation; swapped together under frameMutex
+    std::shared_ptr<const RenderFrame> previousFrame;  // Shapes hold frozen voxel worlds
+    std::shared_ptr<const RenderFrame> currentFrame;
+    mutable std::mutex frameMutex;
+    PoseBuffer poseBuffer;
+    // StepAsync's thread, started by the first call
+    std::thread asyncThread;
+    std::mutex asyncMutex;
+    std::condition_variable asyncQueued;
+    std::deque<std::pair<float, std::shared_ptr<StepState>>> asyncSteps;
+    bool asyncStopping = false;
+    CommandQueue commands;
+    uint64_t stepCount = 0;  // Version stamped on published poses
+    std::atomic<uint64_t> lastStateHash{0};
+    bool deterministic = false;
+    uint64_t colorSeed = 0;  // Random per scene unless SetDeterministic fixes it
+    StateRing savedStates;
+    // Bumped on every add or remove, never reused, so equal versions mean
+    // the same bodies in the same order
+    uint64_t bodySetVersion = 0;
+    uint64_t lastBodySetVersion = 0;
+    std::shared_ptr<const std::vector<RigidBody>> savedBodySet;  // Bodies as of savedBodySetVersion
+    uint64_t savedBodySetVersion = 0;
+    // Voxel worlds are edited in place, so readers on other threads get a
+    // copy that is only re-taken after the world's chunks change
+    VoxelSnapshots voxelSnapshots;
 
     // ✅ Fix: Declare the correct collision function
     void ResolveCollision(RigidBody& a, RigidBody& b, const glm::vec3& overlap);
+
+    // Step stages shared by StepPhysics and the island stepper
+    void IntegrateVelocities(int index, float dt);
+    void ResolveManifolds(std::vector<ContactManifold>& manifolds, float dt);
+    void ResolveContact(RigidBody& a, RigidBody& b, const glm::vec3& point,
+                        const glm::vec3& normal, float penetration, float dt);
+    const glm::mat3& WorldInvInertiaOf(const RigidBody& body) const;
+    void CollidePlanes(int index, std::vector<ContactManifold>& manifolds);
+    void IntegratePositions(RigidBody& body, float dt);
+    void SpawnTestBox();     // Posted on startup and after every reset
+    void ApplyCommands();    // Drain the command queue; the first thing every step does
+    void ApplyVoxelEdits();  // Re-merge edited voxel chunks before the step reads them
+    void PublishStep();         // Runs the publish tasks on their own
+    void AddPublishTasks(TaskGraph& graph, std::initializer_list<TaskGraph::TaskId> after);
+    void PublishQuery();        // Snapshot the finished step for scene queries
+    void PublishRenderFrame();  // Rotate the render buffers for the finished step
+    void PublishPoses();        // Hand the finished step's poses to reader threads
+    void FreezeVoxelWorlds();   // Refresh stale voxelSnapshots before publishing
+
+    int ComputeIslandSubsteps(const Island& island, float dt) const;
+    void AsyncStepLoop();
+    void StepIsland(const Island& island, float dt, std::vector<ContactManifold>& manifolds);
+    ContactManifold DetectPair(int i, int j);  // Picks the narrowphase for the two shapes
+    // Narrowphase for many pairs at once, in parallel chunks. Appends the hits
+    // to manifolds (misses to separatedPairs, the hits' constraints to
+    // constraints) ordered by body ids.
+    void DetectPairs(const std::vector<BodyPair>& pairs, std::vector<ContactManifold>& manifolds,
+                     std::vector<BodyPair>* separatedPairs,
+                     std::vector<ContactConstraint>* constraints = nullptr);
+
+    // Substepping with broadphase and narrowphase done once per frame
+    void FindSweptPairs(float dt, std::vector<BodyPair>& pairs);
+    void ComputeSweptAABBs(float dt, std::vector<AABB>& sweptAABBs);
+    void PrepareContacts(const std::vector<BodyPair>& pairs,
+                         std::vector<ContactConstraint>& constraints,
+                         std::vector<BodyPair>& pendingPairs,
+                         std::vector<ContactManifold>& manifolds);
+    void SolveSubstep(const std::vector<int>& bodyIndices,
+                      std::vector<ContactConstraint>& constraints,
+                      std::vector<BodyPair>& pendingPairs,
+                      float dt);
 };
\ No newline at end of file
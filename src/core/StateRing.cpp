@@ -0,0 +1,24 @@
+#include "StateRing.h"
+
+namespace {
+    constexpr int DEFAULT_CAPACITY = 16;  // Frames kept when nobody called Resize
+}
+
+void StateRing::Resize(int capacity) {
+    slots.clear();
+    slots.resize(capacity > 0 ? capacity : 1);
+}
+
+SavedState& StateRing::SlotFor(uint64_t frame) {
+    if (slots.empty()) Resize(DEFAULT_CAPACITY);
+    SavedState& slot = slots[frame % slots.size()];
+    slot.valid = true;
+    slot.frame = frame;
+    return slot;
+}
+
+const SavedState* StateRing::Find(uint64_t frame) const {
+    if (slots.empty()) return nullptr;
+    const SavedState& slot = slots[frame % slots.size()];
+    return (slot.valid && slot.frame == frame) ? &slot : nullptr;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/PairCache.h"
+
+// The part of a body that stepping changes. Shapes, masses and inertia only
+// change through commands, which start a new body set instead.
+struct BodyState {
+    uint32_t id;
+    bool isSleeping;
+    bool hasAwakened;
+    int sleepCounter;
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec3 forces;
+    glm::vec3 angularVelocity;
+    glm::vec3 torque;
+    glm::quat orientation;
+    glm::vec3 color;
+};
+
+// One saved step
+struct SavedState {
+    bool valid = false;
+    uint64_t frame = 0;
+    // Full bodies as of the last add or remove, shared by every slot saved
+    // since; only needed when restoring across such a change
+    uint64_t bodySetVersion = 0;
+    std::shared_ptr<const std::vector<RigidBody>> bodySet;
+    std::vector<BodyState> bodies;  // Same order as the scene's bodies
+    PairCache::Saved pairs;
+    uint32_t nextHandle = 0;  // So replayed adds get the same handles again
+    uint64_t stateHash = 0;
+};
+
+// A fixed window of saved steps for rollback, indexed by frame modulo the
+// capacity. Slots keep their buffers between laps, so once each has been
+// filled at the current body and pair counts, saving allocates nothing.
+class StateRing {
+public:
+    void Resize(int capacity);  // Drops everything saved so far
+    int Capacity() const { return (int)slots.size(); }
+
+    // The slot to overwrite with frame's state
+    SavedState& SlotFor(uint64_t frame);
+    // nullptr if frame was never saved or has been overwritten since
+    const SavedState* Find(uint64_t frame) const;
+
+private:
+    std::vector<SavedState> slots;
+};
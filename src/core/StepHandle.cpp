@@ -0,0 +1,52 @@
+#include "StepHandle.h"
+
+void StepState::Complete(std::shared_ptr<const SceneQuery> result, uint64_t version, uint64_t hash) {
+    std::vector<std::function<void()>> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        query = std::move(result);
+        poseVersion = version;
+        stateHash = hash;
+        done = true;
+        ready.swap(continuations);
+    }
+    finished.notify_all();
+    // Outside the lock: a resumed coroutine may well inspect this handle again
+    for (std::function<void()>& fn : ready) fn();
+}
+
+bool StepHandle::Ready() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->done;
+}
+
+void StepHandle::Wait() const {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [this] { return state->done; });
+}
+
+void StepHandle::Then(std::function<void()> fn) const {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->done) {
+            state->continuations.push_back(std::move(fn));
+            return;
+        }
+    }
+    fn();
+}
+
+std::shared_ptr<const SceneQuery> StepHandle::Query() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->query;
+}
+
+uint64_t StepHandle::PoseVersion() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->poseVersion;
+}
+
+uint64_t StepHandle::StateHash() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->stateHash;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "physics/collision/SceneQuery.h"
+
+// Shared between Scene::StepAsync's caller and the stepping thread
+struct StepState {
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    std::shared_ptr<const SceneQuery> query;  // The world as this step left it
+    uint64_t poseVersion = 0;
+    uint64_t stateHash = 0;
+    std::vector<std::function<void()>> continuations;
+
+    void Complete(std::shared_ptr<const SceneQuery> result, uint64_t version, uint64_t hash);
+};
+
+// Completion of one Scene::StepAsync. Block on it with Wait(), chain onto it
+// with Then(), or co_await it from a coroutine to get the step's query
+// snapshot. Continuations and resumed coroutines run on the stepping thread
+// right after the step publishes, so hand heavy work back to your own
+// scheduler rather than holding up the next step.
+class StepHandle {
+public:
+    StepHandle() = default;
+    explicit StepHandle(std::shared_ptr<StepState> state) : state(std::move(state)) {}
+
+    bool Ready() const;
+    void Wait() const;
+    // Runs fn once the step is published; right away if it already is
+    void Then(std::function<void()> fn) const;
+
+    // Valid once Ready(): what the completed step published
+    std::shared_ptr<const SceneQuery> Query() const;
+    uint64_t PoseVersion() const;
+    uint64_t StateHash() const;
+
+    bool await_ready() const { return Ready(); }
+    void await_suspend(std::coroutine_handle<> coroutine) const {
+        Then([coroutine] { coroutine.resume(); });
+    }
+    std::shared_ptr<const SceneQuery> await_resume() const { return Query(); }
+
+private:
+    std::shared_ptr<StepState> state;
+};
@@ -0,0 +1,68 @@
+#include "TaskGraph.h"
+#include <algorithm>
+#include <cassert>
+#include "JobSystem.h"
+
+TaskGraph::TaskId TaskGraph::Add(std::function<void()> fn, std::initializer_list<TaskId> dependencies) {
+    TaskId id = (TaskId)tasks.size();
+    tasks.push_back({std::move(fn)});
+    for (TaskId dependency : dependencies) {
+        assert(dependency >= 0 && dependency < id);
+        tasks[dependency].dependents.push_back(id);
+        tasks[id].waitingOn++;
+    }
+    return id;
+}
+
+void TaskGraph::Run() {
+    finished = 0;
+    ready.clear();
+    for (TaskId id = 0; id < (TaskId)tasks.size(); id++) {
+        if (tasks[id].waitingOn == 0) ready.push_back(id);
+    }
+    // Lowest ids first; they were added first and tend to head the longest chains
+    std::reverse(ready.begin(), ready.end());
+    readyCount = (int)ready.size();
+
+    // One drain loop per thread that can help; a thread arriving after the
+    // graph is done just returns
+    int threads = std::min((int)tasks.size(), JobSystem::WorkerCount() + 1);
+    JobSystem::ParallelFor(threads, 1, [this](int, int) { Drain(); });
+}
+
+void TaskGraph::Drain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        if (finished == (int)tasks.size()) return;
+        if (ready.empty()) {
+            // Nothing to start yet: run chunks of the running tasks' nested
+            // ParallelFors rather than leaving them to their own thread
+            lock.unlock();
+            JobSystem::WaitHelping([this] { return CanDrain(); });
+            lock.lock();
+            continue;
+        }
+
+        TaskId id = ready.back();
+        ready.pop_back();
+        readyCount = (int)ready.size();
+        lock.unlock();
+        tasks[id].fn();
+        lock.lock();
+
+        finished++;
+        bool readied = false;
+        for (TaskId dependent : tasks[id].dependents) {
+            if (--tasks[dependent].waitingOn == 0) {
+                ready.push_back(dependent);
+                readied = true;
+            }
+        }
+        readyCount = (int)ready.size();
+        if (readied || finished == (int)tasks.size()) {
+            lock.unlock();
+            JobSystem::Wake();
+            lock.lock();
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+// Small dependency graph of tasks run on the JobSystem's workers. A task
+// starts as soon as every task it depends on has finished, so independent
+// branches overlap. Build it, Run it once, throw it away.
+class TaskGraph {
+public:
+    using TaskId = int;
+
+    // Dependencies must already be in the graph, which rules out cycles
+    TaskId Add(std::function<void()> fn, std::initializer_list<TaskId> dependencies = {});
+
+    // Returns once every task has run. The calling thread runs tasks too, and
+    // a thread with no ready task helps with ParallelFors inside running ones.
+    void Run();
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        std::vector<TaskId> dependents = {};
+        int waitingOn = 0;  // Unfinished dependencies, under mutex
+    };
+
+    void Drain();  // Runs ready tasks until the whole graph is done
+    bool CanDrain() const { return readyCount > 0 || finished == (int)tasks.size(); }
+
+    std::vector<Task> tasks;
+    std::mutex mutex;
+    std::vector<TaskId> ready;
+    // Written under mutex; atomic so waiters can poll them under the JobSystem's lock
+    std::atomic<int> readyCount = 0;
+    std::atomic<int> finished = 0;
+};
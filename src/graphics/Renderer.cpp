@@ -2,6 +2,8 @@
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <vector>
 
 // Cube geometry
 static const float cubeVertices[] = {
@@ -54,6 +56,33 @@ Renderer::Renderer()
     glBufferData(GL_ARRAY_BUFFER, sizeof(planeVertices), planeVertices, GL_STATIC_DRAW);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
+
+    // Sphere VAO/VBO: UV sphere of diameter 1 so it scales like the unit cube
+    const int stacks = 12, slices = 16;
+    const float pi = 3.14159265f;
+    std::vector<float> sphereVertices;
+    auto pushVertex = [&](int stack, int slice) {
+        float theta = pi * stack / stacks;
+        float phi = 2.0f * pi * slice / slices;
+        sphereVertices.push_back(0.5f * std::sin(theta) * std::cos(phi));
+        sphereVertices.push_back(0.5f * std::cos(theta));
+        sphereVertices.push_back(0.5f * std::sin(theta) * std::sin(phi));
+    };
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            pushVertex(i, j);     pushVertex(i + 1, j);     pushVertex(i + 1, j + 1);
+            pushVertex(i, j);     pushVertex(i + 1, j + 1); pushVertex(i, j + 1);
+        }
+    }
+    sphereVertexCount = static_cast<int>(sphereVertices.size() / 3);
+
+    glGenVertexArrays(1, &sphereVAO);
+    glGenBuffers(1, &sphereVBO);
+    glBindVertexArray(sphereVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, sphereVBO);
+    glBufferData(GL_ARRAY_BUFFER, sphereVertices.size() * sizeof(float), sphereVertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
 }
 
 
@@ -64,6 +93,101 @@ void Renderer::DrawCube(const glm::mat4& transform, const glm::vec3& color, Shad
     glDrawArrays(GL_TRIANGLES, 0, 36);
 }
 
+void Renderer::DrawSphere(const glm::mat4& transform, const glm::vec3& color, Shader& shader) {
+    shader.setMat4("model", &transform[0][0]);
+    shader.setVec3("objectColor", color);
+    glBindVertexArray(sphereVAO);
+    glDrawArrays(GL_TRIANGLES, 0, sphereVertexCount);
+}
+
+Renderer::CachedMesh Renderer::UploadTriangles(const std::vector<float>& vertices) {
+    CachedMesh mesh;
+    mesh.vertexCount = static_cast<int>(vertices.size() / 3);
+    glGenVertexArrays(1, &mesh.vao);
+    glGenBuffers(1, &mesh.vbo);
+    glBindVertexArray(mesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    return mesh;
+}
+
+void Renderer::DrawHull(const HullData& hull, const glm::mat4& transform, const glm::vec3& color, Shader& shader) {
+    auto it = cachedMeshes.find(&hull);
+    if (it == cachedMeshes.end()) {
+        // Fan-triangulate each face
+        std::vector<float> vertices;
+        for (const HullFace& face : hull.faces) {
+            uint16_t first = face.edge;
+            const glm::vec3& a = hull.vertices[hull.edges[first].origin];
+            for (uint16_t e = hull.edges[first].next; hull.edges[e].next != first; e = hull.edges[e].next) {
+                const glm::vec3& b = hull.vertices[hull.edges[e].origin];
+                const glm::vec3& c = hull.vertices[hull.edges[hull.edges[e].next].origin];
+                for (const glm::vec3* v : {&a, &b, &c}) {
+                    vertices.push_back(v->x);
+                    vertices.push_back(v->y);
+                    vertices.push_back(v->z);
+                }
+            }
+        }
+        it = cachedMeshes.emplace(&hull, UploadTriangles(vertices)).first;
+    }
+
+    shader.setMat4("model", &transform[0][0]);
+    shader.setVec3("objectColor", color);
+    glBindVertexArray(it->second.vao);
+    glDrawArrays(GL_TRIANGLES, 0, it->second.vertexCount);
+}
+
+void Renderer::DrawMesh(const MeshData& mesh, const glm::mat4& transform, const glm::vec3& color, Shader& shader) {
+    auto it = cachedMeshes.find(&mesh);
+    if (it == cachedMeshes.end()) {
+        std::vector<float> vertices;
+        vertices.reserve(mesh.indices.size() * 3);
+        for (uint32_t index : mesh.indices) {
+            const glm::vec3& v = mesh.vertices[index];
+            vertices.push_back(v.x);
+            vertices.push_back(v.y);
+            vertices.push_back(v.z);
+        }
+        it = cachedMeshes.emplace(&mesh, UploadTriangles(vertices)).first;
+    }
+
+    shader.setMat4("model", &transform[0][0]);
+    shader.setVec3("objectColor", color);
+    glBindVertexArray(it->second.vao);
+    glDrawArrays(GL_TRIANGLES, 0, it->second.vertexCount);
+}
+
+void Renderer::DrawHeightfield(const HeightfieldData& field, const glm::mat4& transform, const glm::vec3& color, Shader& shader) {
+    auto it = cachedMeshes.find(&field);
+    if (it == cachedMeshes.end()) {
+        std::vector<float> vertices;
+        vertices.reserve((size_t)field.CellColumns() * field.CellRows() * 18);
+        glm::vec3 triangles[2][3];
+        uint8_t convexEdges[2];
+        for (int z = 0; z < field.CellRows(); z++) {
+            for (int x = 0; x < field.CellColumns(); x++) {
+                field.CellTriangles(x, z, triangles, convexEdges);
+                for (const auto& triangle : triangles) {
+                    for (const glm::vec3& v : triangle) {
+                        vertices.push_back(v.x);
+                        vertices.push_back(v.y);
+                        vertices.push_back(v.z);
+                    }
+                }
+            }
+        }
+        it = cachedMeshes.emplace(&field, UploadTriangles(vertices)).first;
+    }
+
+    shader.setMat4("model", &transform[0][0]);
+    shader.setVec3("objectColor", color);
+    glBindVertexArray(it->second.vao);
+    glDrawArrays(GL_TRIANGLES, 0, it->second.vertexCount);
+}
+
 void Renderer::DrawPlane(const glm::mat4& transform, Shader& shader) {
     shader.setMat4("model", &transform[0][0]);
     shader.setVec3("objectColor", glm::vec3(0.3f, 0.8f, 0.3f)); // Green floor
@@ -4,7 +4,11 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include "Shader.h"
+#include <unordered_map>
 #include "physics/collision/AABB.h"
+#include "physics/shapes/HullData.h"
+#include "physics/shapes/MeshData.h"
+#include "physics/shapes/HeightfieldData.h"
 
 class Renderer {
 public:
@@ -14,12 +18,27 @@ public:
     Shader wireShader;
 
     void DrawCube(const glm::mat4& transform, const glm::vec3& color, Shader& shader);
+    void DrawSphere(const glm::mat4& transform, const glm::vec3& color, Shader& shader);
+    void DrawHull(const HullData& hull, const glm::mat4& transform, const glm::vec3& color, Shader& shader);
+    void DrawMesh(const MeshData& mesh, const glm::mat4& transform, const glm::vec3& color, Shader& shader);
+    void DrawHeightfield(const HeightfieldData& field, const glm::mat4& transform, const glm::vec3& color, Shader& shader);
     void DrawPlane(const glm::mat4& transform, Shader& shader);
     void DrawWireAABB(const AABB& aabb, const glm::vec3& color, const glm::mat4& viewProj);
 
 private:
     unsigned int cubeVAO, cubeVBO;
     unsigned int planeVAO, planeVBO;
+    unsigned int sphereVAO, sphereVBO;
+    int sphereVertexCount;
+
+    struct CachedMesh {
+        unsigned int vao, vbo;
+        int vertexCount;
+    };
+    // Uploaded once per shared HullData/MeshData/HeightfieldData; the registry keeps those alive
+    std::unordered_map<const void*, CachedMesh> cachedMeshes;
+
+    CachedMesh UploadTriangles(const std::vector<float>& vertices);
 
     unsigned int wireVAO, wireVBO, wireEBO; // For persistent debug AABB rendering
 };
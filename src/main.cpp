@@ -8,6 +8,7 @@
 #include "graphics/Shader.h"
 #include "core/Scene.h"
 #include "core/Camera.h"
+#include "core/PhysicsThread.h"
 
 // Window size
 const unsigned int SCR_WIDTH = 800;
@@ -90,7 +91,8 @@ int main() {
     );
 
     const float fixedDeltaTime = 0.016f; // 60 FPS physics
-    float accumulator = 0.0f;
+    PhysicsThread physics(scene, fixedDeltaTime);
+    physics.Start();
     float currentTime = glfwGetTime();
 
     while (!glfwWindowShouldClose(window)) {
@@ -98,18 +100,11 @@ int main() {
         float frameTime = newTime - currentTime;
         currentTime = newTime;
 
-        accumulator += frameTime;
-
-        // Handle input once per frame (not per physics step)
+        // Handle input once per frame (not per physics step). Edits go through
+        // the scene's command queue, so this never waits on a step.
         scene.HandleInput(window);
         camera.HandleInput(window, frameTime);
 
-        // Physics updates at fixed time step
-        while (accumulator >= fixedDeltaTime) {
-            scene.StepPhysicsWithSubdivision(fixedDeltaTime);
-            accumulator -= fixedDeltaTime;
-        }
-
         // Render
         glClearColor(0.6f, 0.8f, 1.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -122,12 +117,13 @@ int main() {
         shader.setVec3("lightPos", glm::vec3(5.0f, 10.0f, 5.0f));
         shader.setVec3("viewPos", camera.position);
 
-        scene.Render(renderer, shader);
+        scene.Render(renderer, shader, physics.InterpolationAlpha());
 
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
+    physics.Stop();
     glfwDestroyWindow(window);
     glfwTerminate();
     return 0;
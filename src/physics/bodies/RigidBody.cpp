@@ -15,47 +15,109 @@ constexpr float MAX_ANGULAR_VELOCITY = 5.0f;
 constexpr float SLEEP_THRESHOLD = 0.01f;
 constexpr float ANGULAR_SLEEP_THRESHOLD = 0.01f;
 
+std::atomic<uint32_t> RigidBody::nextId{0};
+
+namespace {
+    // SplitMix64 finalizer: every input bit affects every output bit
+    uint64_t Mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+}
+
+glm::vec3 RigidBody::StableColor(uint32_t id, uint64_t seed) {
+    uint64_t bits = Mix(Mix(seed) ^ id);
+    auto channel = [&](int shift) { return ((bits >> shift) & 0xFFFF) / 65536.0f; };
+    return glm::vec3(channel(0), channel(16), channel(32));
+}
+
 RigidBody::RigidBody()
-    : mass(1.0f), position(0.0f), velocity(0.0f), forces(0.0f), isStatic(false) {
+    : id(nextId++), mass(1.0f), position(0.0f), velocity(0.0f), forces(0.0f), isStatic(false) {
     size = glm::vec3(1.0f);
-    shape = std::make_shared<BoxShape>(size * 0.5f);
-    color = glm::vec3(
-        (rand() % 100) / 100.0f,
-        (rand() % 100) / 100.0f,
-        (rand() % 100) / 100.0f
-    );
+    shape = BoxShape(size * 0.5f);
+    color = StableColor(id, 0);
     ComputeInertia();
 }
 
 RigidBody::RigidBody(float m, const glm::vec3& pos)
-    : mass(m), position(pos), velocity(0.0f), forces(0.0f), isStatic(false) {
+    : id(nextId++), mass(m), position(pos), velocity(0.0f), forces(0.0f), isStatic(false) {
     size = glm::vec3(1.0f);
-    shape = std::make_shared<BoxShape>(size * 0.5f);
-    color = glm::vec3(
-        (rand() % 100) / 100.0f,
-        (rand() % 100) / 100.0f,
-        (rand() % 100) / 100.0f
-    );
+    shape = BoxShape(size * 0.5f);
+    color = StableColor(id, 0);
     ComputeInertia();
 }
 
 RigidBody::RigidBody(float m, const glm::vec3& pos, const glm::vec3& sz)
-    : mass(m), position(pos), size(sz), velocity(0.0f), forces(0.0f), isStatic(false) {
-    shape = std::make_shared<BoxShape>(size * 0.5f);
-    color = glm::vec3(
-        (rand() % 100) / 100.0f,
-        (rand() % 100) / 100.0f,
-        (rand() % 100) / 100.0f
-    );
+    : id(nextId++), mass(m), position(pos), size(sz), velocity(0.0f), forces(0.0f), isStatic(false) {
+    shape = BoxShape(size * 0.5f);
+    color = StableColor(id, 0);
     ComputeInertia();
 }
 
+RigidBody::RigidBody(const BodyDesc& desc, uint32_t id)
+    : id(id), layers(desc.layers), position(desc.position), velocity(desc.velocity), forces(0.0f),
+      mass(desc.mass), color(desc.color), orientation(desc.orientation), shape(desc.shape) {
+    size = std::visit([](const auto& s) { return s.GetSize(); }, shape);
+    ShapeType type = GetShapeType();
+    isStatic = mass <= 0.0f || type == ShapeType::Plane || type == ShapeType::TriangleMesh ||
+               type == ShapeType::Heightfield || type == ShapeType::VoxelWorld;
+    if (isStatic) {
+        mass = 0.0f;
+        velocity = glm::vec3(0.0f);
+        hasAwakened = true;
+    }
+}
+
 void RigidBody::ComputeInertia() {
     if (isStatic || mass <= 0.0f) {
         inverseInertiaTensor = glm::mat3(0.0f);
         return;
     }
 
+    if (GetShapeType() == ShapeType::Sphere) {
+        // Solid sphere: I = 2/5 m r^2 about every axis
+        float r = AsSphere().radius;
+        float i = 0.4f * mass * r * r;
+        inertiaTensor = glm::mat3(i);
+        inverseInertiaTensor = glm::mat3(1.0f / i);
+        return;
+    }
+
+    if (GetShapeType() == ShapeType::Capsule) {
+        // Cylinder plus two hemispherical caps, mass split by volume
+        const CapsuleShape& c = AsCapsule();
+        float r = c.radius;
+        float h = c.halfHeight;
+        float cylinderVolume = r * r * 2.0f * h;           // Both volumes share a factor of pi
+        float capsVolume = (4.0f / 3.0f) * r * r * r;
+        float mc = mass * cylinderVolume / (cylinderVolume + capsVolume);
+        float ms = mass - mc;
+        float iy = mc * r * r * 0.5f + ms * 0.4f * r * r;
+        float ixz = mc * (r * r * 0.25f + h * h / 3.0f) + ms * (0.4f * r * r + h * h + 0.75f * h * r);
+        inertiaTensor = glm::mat3(
+            ixz, 0, 0,
+            0, iy, 0,
+            0, 0, ixz
+        );
+        inverseInertiaTensor = glm::inverse(inertiaTensor);
+        return;
+    }
+
+    if (GetShapeType() == ShapeType::ConvexHull) {
+        inertiaTensor = AsHull().hull->inertiaPerMass * mass;
+        inverseInertiaTensor = glm::inverse(inertiaTensor);
+        return;
+    }
+
+    if (GetShapeType() == ShapeType::Compound) {
+        // Children combined once at build time, about the shared center of mass
+        inertiaTensor = AsCompound().compound->inertiaPerMass * mass;
+        inverseInertiaTensor = glm::inverse(inertiaTensor);
+        return;
+    }
+
     glm::vec3 dims = size;
     float ix = (1.0f / 12.0f) * mass * (dims.y * dims.y + dims.z * dims.z);
     float iy = (1.0f / 12.0f) * mass * (dims.x * dims.x + dims.z * dims.z);
@@ -111,7 +173,11 @@ void RigidBody::IntegrateAngularVelocity(float dt) {
 
     // Convert local inverse inertia tensor to world space
     glm::mat3 R = glm::toMat3(orientation);
-    glm::mat3 worldInvInertia = R * inverseInertiaTensor * glm::transpose(R);
+    IntegrateAngularVelocity(dt, R * inverseInertiaTensor * glm::transpose(R));
+}
+
+void RigidBody::IntegrateAngularVelocity(float dt, const glm::mat3& worldInvInertia) {
+    if (isStatic) return;
 
     glm::vec3 angAccel = worldInvInertia * torque;
     angularVelocity += angAccel * dt;
@@ -156,31 +222,81 @@ void RigidBody::IntegrateOrientation(float dt) {
 }
 
 AABB RigidBody::GetAABB() const {
-    if (!shape) return AABB(position, position);
+    return ComputeAABB(glm::toMat3(orientation));
+}
 
-    glm::vec3 halfExtents = shape->halfExtents;
-    glm::mat3 rot = glm::toMat3(orientation);
+AABB RigidBody::ComputeAABB(const glm::mat3& rot) const {
+    return std::visit([&](const auto& s) { return s.ComputeAABB(position, rot); }, shape);
+}
 
-    glm::vec3 absRot[3] = {
-        glm::abs(rot[0]),
-        glm::abs(rot[1]),
-        glm::abs(rot[2])
-    };
 
-    glm::vec3 worldHalfExtents =
-        absRot[0] * halfExtents.x +
-        absRot[1] * halfExtents.y +
-        absRot[2] * halfExtents.z;
+void RigidBody::SetShapeAndSize(const glm::vec3& fullSize) {
+    size = fullSize;
+    shape = BoxShape(size * 0.5f);
+    ComputeInertia();
+}
 
-    glm::vec3 aabbMin = position - worldHalfExtents;
-    glm::vec3 aabbMax = position + worldHalfExtents;
+void RigidBody::SetSphere(float radius) {
+    shape = SphereShape(radius);
+    size = glm::vec3(radius * 2.0f);
+    ComputeInertia();
+}
 
-    return AABB(aabbMin, aabbMax);
+void RigidBody::SetCapsule(float radius, float halfHeight) {
+    shape = CapsuleShape(radius, halfHeight);
+    size = AsCapsule().GetSize();
+    ComputeInertia();
 }
 
+void RigidBody::SetConvexHull(std::shared_ptr<const HullData> hull) {
+    shape = ConvexHullShape(std::move(hull));
+    size = AsHull().GetSize();
+    ComputeInertia();
+}
 
-void RigidBody::SetShapeAndSize(const glm::vec3& fullSize) {
-    size = fullSize;
-    shape = std::make_shared<BoxShape>(size * 0.5f);
+void RigidBody::SetCompound(std::shared_ptr<const CompoundData> compound) {
+    shape = CompoundShape(std::move(compound));
+    size = AsCompound().GetSize();
     ComputeInertia();
-}
\ No newline at end of file
+}
+
+void RigidBody::SetTriangleMesh(std::shared_ptr<const MeshData> mesh) {
+    shape = TriangleMeshShape(std::move(mesh));
+    size = AsMesh().GetSize();
+    isStatic = true;
+    mass = 0.0f;
+    velocity = glm::vec3(0.0f);
+    angularVelocity = glm::vec3(0.0f);
+    ComputeInertia();
+}
+
+void RigidBody::SetHeightfield(std::shared_ptr<const HeightfieldData> field) {
+    shape = HeightfieldShape(std::move(field));
+    size = AsHeightfield().GetSize();
+    isStatic = true;
+    mass = 0.0f;
+    velocity = glm::vec3(0.0f);
+    angularVelocity = glm::vec3(0.0f);
+    ComputeInertia();
+}
+
+void RigidBody::SetVoxelWorld(std::shared_ptr<VoxelWorld> world) {
+    shape = VoxelWorldShape(std::move(world));
+    size = AsVoxelWorld().GetSize();
+    isStatic = true;
+    mass = 0.0f;
+    velocity = glm::vec3(0.0f);
+    angularVelocity = glm::vec3(0.0f);
+    ComputeInertia();
+}
+
+void RigidBody::SetPlane(const glm::vec3& normal, float offset) {
+    shape = PlaneShape(normal, offset);
+    isStatic = true;
+    mass = 0.0f;
+    position = AsPlane().normal * offset;
+    orientation = glm::quat(1, 0, 0, 0);
+    velocity = glm::vec3(0.0f);
+    angularVelocity = glm::vec3(0.0f);
+    ComputeInertia();
+}
@@ -1,14 +1,29 @@
 #pragma once
 #include <glm/glm.hpp>
 #include "physics/collision/Collider.h"
-#include "physics/shapes/BoxShape.h"
-#include "physics/shapes/SphereShape.h"
+#include "physics/shapes/Shape.h"
 #include <glm/gtc/quaternion.hpp>
+#include <atomic>
 #include <memory>
+#include <cstdint>
 
+// Everything needed to spawn a body in bulk. Unlike the RigidBody
+// constructors, building from one rolls no random color and leaves the
+// inertia to ComputeInertia, so batches can do that step together.
+struct BodyDesc {
+    Shape shape = BoxShape(glm::vec3(0.5f));
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 velocity = glm::vec3(0.0f);
+    float mass = 1.0f;  // 0 makes the body static; meshes, heightfields and voxels always are
+    glm::vec3 color = glm::vec3(0.7f);
+    uint32_t layers = 1;
+};
 
 class RigidBody {
 public:
+    uint32_t id;  // Stable across copies and vector reshuffles; keys the pair cache
+    uint32_t layers = 1;  // Query layer bits; scene queries skip bodies sharing none with their mask
     glm::vec3 position;
     glm::vec3 velocity;
     glm::vec3 forces;
@@ -29,14 +44,21 @@ public:
     glm::mat3 inverseInertiaTensor;
 
     Collider collider; // Each RigidBody has a collider now
-    std::shared_ptr<BoxShape> shape;
-    std::shared_ptr<SphereShape> sphereShape;
+    Shape shape = BoxShape(glm::vec3(0.5f));
 
 
     RigidBody(); // Default constructor
     RigidBody(float m, const glm::vec3& pos); // Constructor with mass and position (declaration only here!)
 
     RigidBody(float m, const glm::vec3& pos, const glm::vec3& sz);
+    RigidBody(const BodyDesc& desc, uint32_t id);  // id from CommandQueue::ReserveHandles; call ComputeInertia after
+
+    // Id of stand-in bodies that never join a scene, e.g. narrowphase proxies.
+    // Build those through the BodyDesc constructor so they take no id from nextId.
+    static constexpr uint32_t NO_ID = ~0u;
+
+    // Channels in [0, 1), the same for the same id and seed on any thread or run
+    static glm::vec3 StableColor(uint32_t id, uint64_t seed);
 
     void ApplyForce(const glm::vec3& force);
     void ApplyPhysics(float dt);
@@ -44,14 +66,38 @@ public:
     void IntegratePosition(float dt);
     void ApplyTorque(const glm::vec3& t);
     void IntegrateAngularVelocity(float dt);
+    void IntegrateAngularVelocity(float dt, const glm::mat3& worldInvInertia);
     void IntegrateOrientation(float dt);
     void ComputeInertia();
     void SetShapeAndSize(const glm::vec3& fullSize);
     void SetSphere(float radius);
+    void SetPlane(const glm::vec3& normal, float offset);
+    void SetCapsule(float radius, float halfHeight);
+    void SetConvexHull(std::shared_ptr<const HullData> hull);
+    void SetTriangleMesh(std::shared_ptr<const MeshData> mesh);  // Always static
+    void SetHeightfield(std::shared_ptr<const HeightfieldData> field);  // Always static
+    void SetVoxelWorld(std::shared_ptr<VoxelWorld> world);  // Always static
+    void SetCompound(std::shared_ptr<const CompoundData> compound);
+
 
+    ShapeType GetShapeType() const { return static_cast<ShapeType>(shape.index()); }
+    const BoxShape& AsBox() const { return std::get<BoxShape>(shape); }
+    const SphereShape& AsSphere() const { return std::get<SphereShape>(shape); }
+    const PlaneShape& AsPlane() const { return std::get<PlaneShape>(shape); }
+    const CapsuleShape& AsCapsule() const { return std::get<CapsuleShape>(shape); }
+    const ConvexHullShape& AsHull() const { return std::get<ConvexHullShape>(shape); }
+    const TriangleMeshShape& AsMesh() const { return std::get<TriangleMeshShape>(shape); }
+    const HeightfieldShape& AsHeightfield() const { return std::get<HeightfieldShape>(shape); }
+    const VoxelWorldShape& AsVoxelWorld() const { return std::get<VoxelWorldShape>(shape); }
+    const CompoundShape& AsCompound() const { return std::get<CompoundShape>(shape); }
 
     AABB GetAABB() const;
+    AABB ComputeAABB(const glm::mat3& rot) const;  // With the rotation already converted
 
+private:
+    // Bodies are built on input threads too. A scene's queue replaces the id
+    // with a handle of its own, so these never reach the simulation.
+    static std::atomic<uint32_t> nextId;
 };
 
 // Free function declaration (outside of class)
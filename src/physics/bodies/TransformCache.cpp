@@ -0,0 +1,71 @@
+#include "TransformCache.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/quaternion.hpp>
+#include <algorithm>
+#include <limits>
+#include "core/JobSystem.h"
+
+namespace {
+    constexpr int UPDATE_GRAIN = 512;  // Bodies per job in a full update
+}
+
+void TransformCache::Update(const std::vector<RigidBody>& bodies) {
+    Resize(bodies.size());
+    // Slots are independent, so the full update goes wide
+    JobSystem::ParallelFor((int)bodies.size(), UPDATE_GRAIN, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            UpdateBody(bodies[i], i);
+        }
+    });
+}
+
+void TransformCache::Update(const std::vector<RigidBody>& bodies, const std::vector<int>& indices) {
+    Resize(bodies.size());
+    for (int index : indices) {
+        UpdateBody(bodies[index], index);
+    }
+}
+
+void TransformCache::Invalidate(int index) {
+    if (index < (int)frozen.size()) frozen[index] = 0;
+}
+
+void TransformCache::Compact(const std::vector<uint8_t>& removed) {
+    int count = std::min((int)removed.size(), (int)ids.size());
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (removed[i]) continue;
+        if (kept != i) {
+            rotations[kept] = rotations[i];
+            worldAABBs[kept] = worldAABBs[i];
+            worldInvInertia[kept] = worldInvInertia[i];
+            ids[kept] = ids[i];
+            frozen[kept] = frozen[i];
+        }
+        kept++;
+    }
+    // Slots past removed.size() belonged to bodies added this batch, never computed
+    Resize(kept);
+}
+
+void TransformCache::Resize(size_t count) {
+    if (ids.size() == count) return;
+    rotations.resize(count);
+    worldAABBs.resize(count);
+    worldInvInertia.resize(count);
+    ids.resize(count, std::numeric_limits<uint32_t>::max());
+    frozen.resize(count, 0);
+}
+
+void TransformCache::UpdateBody(const RigidBody& body, int index) {
+    // Static and sleeping bodies don't move, so a slot computed in that state stays valid
+    bool isFrozen = body.isStatic || body.isSleeping;
+    if (ids[index] == body.id && frozen[index] && isFrozen) return;
+
+    glm::mat3 rot = glm::toMat3(body.orientation);
+    rotations[index] = rot;
+    worldAABBs[index] = body.ComputeAABB(rot);
+    worldInvInertia[index] = rot * body.inverseInertiaTensor * glm::transpose(rot);
+    ids[index] = body.id;
+    frozen[index] = isFrozen;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "RigidBody.h"
+
+// Per-step derived transform data, one slot per body, computed once and read by
+// every later stage (broadphase, SAT, integration, solver).
+// Static and sleeping bodies keep their slot until the body in it changes.
+class TransformCache {
+public:
+    std::vector<glm::mat3> rotations;
+    std::vector<AABB> worldAABBs;
+    std::vector<glm::mat3> worldInvInertia;
+
+    void Update(const std::vector<RigidBody>& bodies);
+    void Update(const std::vector<RigidBody>& bodies, const std::vector<int>& indices);
+    // Recompute a frozen slot next Update, e.g. after a static body's shape was edited
+    void Invalidate(int index);
+    // Drop the slots flagged in removed, keeping the rest lined up with bodies
+    // compacted the same way, so their frozen slots stay valid
+    void Compact(const std::vector<uint8_t>& removed);
+
+private:
+    void Resize(size_t count);
+    void UpdateBody(const RigidBody& body, int index);
+
+    std::vector<uint32_t> ids;    // Which body each slot was computed for
+    std::vector<uint8_t> frozen;  // Slot was computed while the body was static or asleep
+};
@@ -0,0 +1,177 @@
+#include "Broadphase.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+namespace {
+    void SortByMinX(const std::vector<AABB>& aabbs, std::vector<int>& order) {
+        std::sort(order.begin(), order.end(), [&](int l, int r) {
+            return aabbs[l].min.x < aabbs[r].min.x;
+        });
+    }
+
+    void AddPair(std::vector<BodyPair>& outPairs, int i, int j) {
+        outPairs.push_back({std::min(i, j), std::max(i, j)});
+    }
+
+    // Keep the same pair order as the old all-pairs loop
+    void SortPairs(std::vector<BodyPair>& pairs) {
+        std::sort(pairs.begin(), pairs.end(), [](const BodyPair& l, const BodyPair& r) {
+            return l.a != r.a ? l.a < r.a : l.b < r.b;
+        });
+    }
+}
+
+void Broadphase::FindPairs(const std::vector<AABB>& aabbs, std::vector<BodyPair>& outPairs) {
+    std::vector<int> all(aabbs.size());
+    std::iota(all.begin(), all.end(), 0);
+    FindPairs(aabbs, all, outPairs);
+}
+
+void Broadphase::FindPairs(const std::vector<AABB>& aabbs, const std::vector<int>& subset,
+                           std::vector<BodyPair>& outPairs) {
+    outPairs.clear();
+
+    std::vector<int> order(subset);
+    SortByMinX(aabbs, order);
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        const AABB& boxA = aabbs[order[i]];
+        for (size_t j = i + 1; j < order.size(); ++j) {
+            const AABB& boxB = aabbs[order[j]];
+            if (boxB.min.x > boxA.max.x) break;  // Nothing further along X can overlap
+            if (boxA.Overlaps(boxB)) AddPair(outPairs, order[i], order[j]);
+        }
+    }
+    SortPairs(outPairs);
+}
+
+void Broadphase::FindPairsBetween(const std::vector<AABB>& aabbs, const std::vector<int>& setA,
+                                  const std::vector<int>& setB, std::vector<BodyPair>& outPairs) {
+    outPairs.clear();
+
+    std::vector<int> orderA(setA), orderB(setB);
+    SortByMinX(aabbs, orderA);
+    SortByMinX(aabbs, orderB);
+
+    // Sweep both lists together: whichever box starts first is tested against
+    // the other list's boxes that start before it ends
+    auto sweep = [&](int index, const std::vector<int>& other, size_t from) {
+        const AABB& box = aabbs[index];
+        for (size_t k = from; k < other.size(); ++k) {
+            const AABB& otherBox = aabbs[other[k]];
+            if (otherBox.min.x > box.max.x) break;
+            if (box.Overlaps(otherBox)) AddPair(outPairs, index, other[k]);
+        }
+    };
+    size_t i = 0, j = 0;
+    while (i < orderA.size() && j < orderB.size()) {
+        if (aabbs[orderA[i]].min.x <= aabbs[orderB[j]].min.x) sweep(orderA[i++], orderB, j);
+        else sweep(orderB[j++], orderA, i);
+    }
+    SortPairs(outPairs);
+}
+
+AABB Broadphase::ExpandByVelocity(const AABB& aabb, const glm::vec3& velocity, float dt, float margin) {
+    glm::vec3 motion = velocity * dt;
+    glm::vec3 grow(margin);
+    return AABB(aabb.min + glm::min(motion, glm::vec3(0.0f)) - grow,
+                aabb.max + glm::max(motion, glm::vec3(0.0f)) + grow);
+}
+
+void BroadphaseTree::Build(const std::vector<AABB>& aabbs) {
+    nodes.clear();
+    if (aabbs.empty()) return;
+
+    std::vector<uint32_t> order(aabbs.size());
+    std::iota(order.begin(), order.end(), 0);
+    nodes.reserve(aabbs.size() * 2);
+
+    // Depth-first with median splits on the longest axis of the centers, so
+    // the depth stays near log2(n) whatever the scene looks like
+    auto build = [&](auto& self, uint32_t begin, uint32_t end) -> uint32_t {
+        uint32_t index = (uint32_t)nodes.size();
+        nodes.emplace_back();
+
+        AABB box(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+        glm::vec3 centerMin(FLT_MAX), centerMax(-FLT_MAX);
+        for (uint32_t i = begin; i < end; i++) {
+            const AABB& b = aabbs[order[i]];
+            box.min = glm::min(box.min, b.min);
+            box.max = glm::max(box.max, b.max);
+            centerMin = glm::min(centerMin, b.min + b.max);
+            centerMax = glm::max(centerMax, b.min + b.max);
+        }
+        nodes[index].bounds = box;
+
+        if (end - begin == 1) {
+            nodes[index].payload = BroadphaseNode::LEAF_FLAG | order[begin];
+            return index;
+        }
+
+        glm::vec3 extent = centerMax - centerMin;
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        uint32_t mid = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](uint32_t x, uint32_t y) {
+            return aabbs[x].min[axis] + aabbs[x].max[axis] < aabbs[y].min[axis] + aabbs[y].max[axis];
+        });
+
+        self(self, begin, mid);
+        uint32_t right = self(self, mid, end);
+        nodes[index].payload = right;
+        return index;
+    };
+    build(build, 0, (uint32_t)aabbs.size());
+}
+
+bool BroadphaseTree::SegmentHits(const AABB& bounds, const glm::vec3& extent, const glm::vec3& origin,
+                                 const glm::vec3& invDir, float maxT) {
+    float tMin = 0.0f;
+    float tMax = maxT;
+    for (int axis = 0; axis < 3; axis++) {
+        float lo = bounds.min[axis] - extent[axis] - origin[axis];
+        float hi = bounds.max[axis] + extent[axis] - origin[axis];
+        if (std::isinf(invDir[axis])) {
+            // Parallel to the slab: inside it or never
+            if (lo > 0.0f || hi < 0.0f) return false;
+            continue;
+        }
+        float t0 = lo * invDir[axis];
+        float t1 = hi * invDir[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) return false;
+    }
+    return true;
+}
+
+void RayPacket::SetRay(int lane, const glm::vec3& origin, const glm::vec3& dir, float maxDistance) {
+    // A huge finite reciprocal keeps the lane math free of inf * 0 NaNs
+    auto safeInverse = [](float d) { return 1.0f / (std::abs(d) < 1e-20f ? (d < 0.0f ? -1e-20f : 1e-20f) : d); };
+    originX[lane] = origin.x;
+    originY[lane] = origin.y;
+    originZ[lane] = origin.z;
+    invDirX[lane] = safeInverse(dir.x);
+    invDirY[lane] = safeInverse(dir.y);
+    invDirZ[lane] = safeInverse(dir.z);
+    maxT[lane] = maxDistance;
+}
+
+uint32_t RayPacket::SlabTest(const AABB& bounds) const {
+    float tMin[WIDTH], tMax[WIDTH];
+    for (int i = 0; i < WIDTH; i++) {
+        float x0 = (bounds.min.x - originX[i]) * invDirX[i];
+        float x1 = (bounds.max.x - originX[i]) * invDirX[i];
+        float y0 = (bounds.min.y - originY[i]) * invDirY[i];
+        float y1 = (bounds.max.y - originY[i]) * invDirY[i];
+        float z0 = (bounds.min.z - originZ[i]) * invDirZ[i];
+        float z1 = (bounds.max.z - originZ[i]) * invDirZ[i];
+        tMin[i] = std::max(std::max(std::min(x0, x1), std::min(y0, y1)), std::max(std::min(z0, z1), 0.0f));
+        tMax[i] = std::min(std::min(std::max(x0, x1), std::max(y0, y1)), std::min(std::max(z0, z1), maxT[i]));
+    }
+    uint32_t mask = 0;
+    for (int i = 0; i < WIDTH; i++) mask |= (uint32_t)(tMin[i] <= tMax[i]) << i;
+    return mask;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "AABB.h"
+
+// A pair of body indices whose AABBs overlap (a < b)
+struct BodyPair {
+    int a;
+    int b;
+};
+
+class Broadphase {
+public:
+    // Sort-and-sweep along X. Pairs come out ordered by (a, b).
+    static void FindPairs(const std::vector<AABB>& aabbs, std::vector<BodyPair>& outPairs);
+    // Same, among the listed indices only
+    static void FindPairs(const std::vector<AABB>& aabbs, const std::vector<int>& subset,
+                          std::vector<BodyPair>& outPairs);
+    // Pairs with one index from each list, e.g. dynamic bodies against static ones
+    static void FindPairsBetween(const std::vector<AABB>& aabbs, const std::vector<int>& setA,
+                                 const std::vector<int>& setB, std::vector<BodyPair>& outPairs);
+
+    // AABB grown to cover the motion over dt, so pairs stay valid for every substep of a frame
+    static AABB ExpandByVelocity(const AABB& aabb, const glm::vec3& velocity, float dt, float margin);
+};
+
+// Same flattened layout as CompoundNode: left child follows its parent
+struct BroadphaseNode {
+    AABB bounds;
+    // Interior: index of the right child. Leaf: LEAF_FLAG | body index.
+    uint32_t payload;
+
+    static constexpr uint32_t LEAF_FLAG = 0x80000000u;
+
+    bool IsLeaf() const { return (payload & LEAF_FLAG) != 0; }
+    uint32_t RightChild() const { return payload; }
+    uint32_t Body() const { return payload & ~LEAF_FLAG; }
+};
+
+// Rays in SoA form, one per lane, so the slab test runs across all lanes at
+// once (plain loops the compiler turns into SSE/NEON). Empty lanes have maxT < 0.
+struct RayPacket {
+    static constexpr int WIDTH = 4;
+
+    float originX[WIDTH], originY[WIDTH], originZ[WIDTH];
+    float invDirX[WIDTH], invDirY[WIDTH], invDirZ[WIDTH];  // Never infinite, see SetRay
+    float maxT[WIDTH];
+
+    void SetRay(int lane, const glm::vec3& origin, const glm::vec3& dir, float maxDistance);
+    void Clear(int lane) { maxT[lane] = -1.0f; }
+
+    // Bit per lane whose live segment [0, maxT] crosses bounds
+    uint32_t SlabTest(const AABB& bounds) const;
+};
+
+// AABB tree over body bounds, rebuilt from scratch for each completed step
+// so scene queries don't have to touch every body. Read-only once built.
+class BroadphaseTree {
+public:
+    void Build(const std::vector<AABB>& aabbs);
+    bool Empty() const { return nodes.empty(); }
+
+    // Bodies whose bounds overlap box; fn(index) returns false to stop
+    template <class Fn>
+    void Query(const AABB& box, Fn&& fn) const {
+        if (nodes.empty()) return;
+        uint32_t stack[MAX_DEPTH];
+        int top = 0;
+        uint32_t index = 0;
+        for (;;) {
+            const BroadphaseNode& node = nodes[index];
+            if (node.bounds.Overlaps(box)) {
+                if (node.IsLeaf()) {
+                    if (!fn((int)node.Body())) return;
+                } else {
+                    stack[top++] = node.RightChild();
+                    index++;
+                    continue;
+                }
+            }
+            if (top == 0) break;
+            index = stack[--top];
+        }
+    }
+
+    // Bodies whose bounds, grown by extent, the segment origin + dir * [0, maxT]
+    // passes through. fn(index, maxT) may shorten maxT; returns false to stop.
+    template <class Fn>
+    void Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxT,
+                 const glm::vec3& extent, Fn&& fn) const {
+        if (nodes.empty()) return;
+        glm::vec3 invDir = 1.0f / dir;
+        uint32_t stack[MAX_DEPTH];
+        int top = 0;
+        uint32_t index = 0;
+        for (;;) {
+            const BroadphaseNode& node = nodes[index];
+            if (SegmentHits(node.bounds, extent, origin, invDir, maxT)) {
+                if (node.IsLeaf()) {
+                    if (!fn((int)node.Body(), maxT)) return;
+                } else {
+                    stack[top++] = node.RightChild();
+                    index++;
+                    continue;
+                }
+            }
+            if (top == 0) break;
+            index = stack[--top];
+        }
+    }
+
+    // Whole packet walks the tree once; a subtree is skipped when no lane
+    // reaches it. fn(index, laneMask) may shorten lanes' maxT; false stops.
+    template <class Fn>
+    void RaycastPacket(RayPacket& packet, Fn&& fn) const {
+        if (nodes.empty()) return;
+        uint32_t stack[MAX_DEPTH];
+        int top = 0;
+        uint32_t index = 0;
+        for (;;) {
+            const BroadphaseNode& node = nodes[index];
+            uint32_t lanes = packet.SlabTest(node.bounds);
+            if (lanes != 0) {
+                if (node.IsLeaf()) {
+                    if (!fn((int)node.Body(), lanes)) return;
+                } else {
+                    stack[top++] = node.RightChild();
+                    index++;
+                    continue;
+                }
+            }
+            if (top == 0) break;
+            index = stack[--top];
+        }
+    }
+
+    // Slab test against bounds grown by extent
+    static bool SegmentHits(const AABB& bounds, const glm::vec3& extent, const glm::vec3& origin,
+                            const glm::vec3& invDir, float maxT);
+
+private:
+    static constexpr int MAX_DEPTH = 64;
+
+    std::vector<BroadphaseNode> nodes;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// Closest-point primitives shared by the narrowphase kernels (after Ericson,
+// Real-Time Collision Detection, ch. 5)
+namespace ClosestPoint {
+
+    // Closest points between segments p1-q1 and p2-q2
+    inline void Segments(const glm::vec3& p1, const glm::vec3& q1,
+                         const glm::vec3& p2, const glm::vec3& q2,
+                         glm::vec3& c1, glm::vec3& c2) {
+        glm::vec3 d1 = q1 - p1, d2 = q2 - p2, r = p1 - p2;
+        float a = glm::dot(d1, d1), e = glm::dot(d2, d2), f = glm::dot(d2, r);
+        float s = 0.0f, t = 0.0f;
+        if (a <= 1e-12f && e <= 1e-12f) {
+            c1 = p1;
+            c2 = p2;
+            return;
+        }
+        if (a <= 1e-12f) {
+            t = glm::clamp(f / e, 0.0f, 1.0f);
+        } else {
+            float c = glm::dot(d1, r);
+            if (e <= 1e-12f) {
+                s = glm::clamp(-c / a, 0.0f, 1.0f);
+            } else {
+                float b = glm::dot(d1, d2);
+                float denom = a * e - b * b;
+                s = denom > 1e-12f ? glm::clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+                t = (b * s + f) / e;
+                if (t < 0.0f) {
+                    t = 0.0f;
+                    s = glm::clamp(-c / a, 0.0f, 1.0f);
+                } else if (t > 1.0f) {
+                    t = 1.0f;
+                    s = glm::clamp((b - c) / a, 0.0f, 1.0f);
+                }
+            }
+        }
+        c1 = p1 + d1 * s;
+        c2 = p2 + d2 * t;
+    }
+
+    // Closest point to p on triangle abc
+    inline glm::vec3 OnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+        glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+        float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+        glm::vec3 bp = p - b;
+        float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) return b;
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+
+        glm::vec3 cp = p - c;
+        float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) return c;
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+            return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        }
+
+        float denom = 1.0f / (va + vb + vc);
+        return a + ab * (vb * denom) + ac * (vc * denom);
+    }
+}
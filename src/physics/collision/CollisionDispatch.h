@@ -0,0 +1,289 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/ContactManifold.h"
+#include "physics/collision/PairCache.h"
+#include "physics/collision/SATCollision.h"
+#include "physics/collision/SphereCollision.h"
+#include "physics/collision/PlaneCollision.h"
+#include "physics/collision/ConvexCollision.h"
+#include "physics/collision/HullCollision.h"
+#include "physics/collision/MeshCollision.h"
+#include "physics/collision/VoxelCollision.h"
+#include "physics/collision/CompoundCollision.h"
+
+// Narrowphase kernel for one (shapeA, shapeB) combination
+using NarrowphaseFn = ContactManifold (*)(const RigidBody& a, const glm::mat3& rotA,
+                                          const RigidBody& b, const glm::mat3& rotB,
+                                          PairCache& cache);
+
+// Specialize for each supported combination. Pairs only specialized in the
+// other order get a flipped kernel, remaining convex pairs fall back to
+// GJK/EPA, and anything else never collides.
+template <class ShapeA, class ShapeB>
+struct Narrowphase {
+    static constexpr bool defined = false;
+};
+
+template <>
+struct Narrowphase<BoxShape, BoxShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache& cache) {
+        return SATCollision::DetectCollision(a, rotA, b, rotB, cache.Get(a.id, b.id));
+    }
+};
+
+template <>
+struct Narrowphase<SphereShape, SphereShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3&,
+                                  const RigidBody& b, const glm::mat3&, PairCache&) {
+        return SphereCollision::DetectSpheres(a, b);
+    }
+};
+
+template <>
+struct Narrowphase<SphereShape, BoxShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3&,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return SphereCollision::DetectSphereBox(a, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<BoxShape, SphereShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3&, PairCache&) {
+        return SphereCollision::DetectBoxSphere(a, rotA, b);
+    }
+};
+
+template <>
+struct Narrowphase<PlaneShape, BoxShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3&,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return PlaneCollision::DetectBox(a, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<PlaneShape, SphereShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3&,
+                                  const RigidBody& b, const glm::mat3&, PairCache&) {
+        return PlaneCollision::DetectSphere(a, b);
+    }
+};
+
+template <>
+struct Narrowphase<PlaneShape, CapsuleShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3&,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return PlaneCollision::DetectCapsule(a, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<PlaneShape, ConvexHullShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3&,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return PlaneCollision::DetectHull(a, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<ConvexHullShape, ConvexHullShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return HullCollision::DetectHulls(a, rotA, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<ConvexHullShape, BoxShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return HullCollision::DetectHullBox(a, rotA, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<TriangleMeshShape, BoxShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return MeshCollision::DetectBox(a, rotA, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<TriangleMeshShape, SphereShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3&, PairCache&) {
+        return MeshCollision::DetectSphere(a, rotA, b);
+    }
+};
+
+template <>
+struct Narrowphase<HeightfieldShape, BoxShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return MeshCollision::DetectHeightfieldBox(a, rotA, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<HeightfieldShape, SphereShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3&, PairCache&) {
+        return MeshCollision::DetectHeightfieldSphere(a, rotA, b);
+    }
+};
+
+template <>
+struct Narrowphase<HeightfieldShape, CapsuleShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return MeshCollision::DetectHeightfieldCapsule(a, rotA, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<HeightfieldShape, ConvexHullShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return MeshCollision::DetectHeightfieldHull(a, rotA, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<VoxelWorldShape, BoxShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return VoxelCollision::DetectBox(a, rotA, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<VoxelWorldShape, SphereShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3&, PairCache&) {
+        return VoxelCollision::DetectSphere(a, rotA, b);
+    }
+};
+
+template <>
+struct Narrowphase<VoxelWorldShape, CapsuleShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return VoxelCollision::DetectConvex(a, rotA, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<VoxelWorldShape, ConvexHullShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return VoxelCollision::DetectConvex(a, rotA, b, rotB);
+    }
+};
+
+// A compound against anything: descend into its children
+template <class ShapeB>
+struct Narrowphase<CompoundShape, ShapeB> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return CompoundCollision::Detect(a, rotA, b, rotB);
+    }
+};
+
+template <>
+struct Narrowphase<CompoundShape, CompoundShape> {
+    static constexpr bool defined = true;
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache&) {
+        return CompoundCollision::DetectCompounds(a, rotA, b, rotB);
+    }
+};
+
+namespace CollisionDispatch {
+
+    // Run the (B, A) kernel and express the result as A -> B
+    template <class ShapeA, class ShapeB>
+    ContactManifold DetectFlipped(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache& cache) {
+        ContactManifold m = Narrowphase<ShapeB, ShapeA>::Detect(b, rotB, a, rotA, cache);
+        std::swap(m.a, m.b);
+        m.normal = -m.normal;
+        for (ContactPoint& cp : m.contacts) {
+            cp.point += cp.normal * cp.penetration;  // Move onto the new B's surface
+            cp.normal = -cp.normal;
+        }
+        return m;
+    }
+
+    inline ContactManifold DetectNothing(const RigidBody& a, const glm::mat3&,
+                                         const RigidBody& b, const glm::mat3&, PairCache&) {
+        ContactManifold m;
+        m.a = (RigidBody*)&a;
+        m.b = (RigidBody*)&b;
+        return m;
+    }
+
+    inline ContactManifold DetectConvex(const RigidBody& a, const glm::mat3& rotA,
+                                        const RigidBody& b, const glm::mat3& rotB, PairCache& cache) {
+        return ConvexCollision::Detect(a, rotA, b, rotB, cache.Get(a.id, b.id));
+    }
+
+    template <size_t I, size_t J>
+    constexpr NarrowphaseFn SelectKernel() {
+        using A = std::variant_alternative_t<I, Shape>;
+        using B = std::variant_alternative_t<J, Shape>;
+        if constexpr (Narrowphase<A, B>::defined) return &Narrowphase<A, B>::Detect;
+        else if constexpr (Narrowphase<B, A>::defined) return &DetectFlipped<A, B>;
+        else if constexpr (ConvexShape<A> && ConvexShape<B>) return &DetectConvex;
+        else return &DetectNothing;
+    }
+
+    template <size_t... K>
+    constexpr std::array<NarrowphaseFn, sizeof...(K)> MakeTable(std::index_sequence<K...>) {
+        return {SelectKernel<K / SHAPE_TYPE_COUNT, K % SHAPE_TYPE_COUNT>()...};
+    }
+
+    // Row-major [shapeA][shapeB], built at compile time from the Shape variant
+    inline constexpr std::array<NarrowphaseFn, SHAPE_TYPE_COUNT * SHAPE_TYPE_COUNT> TABLE =
+        MakeTable(std::make_index_sequence<SHAPE_TYPE_COUNT * SHAPE_TYPE_COUNT>{});
+
+    inline uint32_t PairKey(ShapeType a, ShapeType b) {
+        return static_cast<uint32_t>(a) * SHAPE_TYPE_COUNT + static_cast<uint32_t>(b);
+    }
+
+    inline NarrowphaseFn Lookup(ShapeType a, ShapeType b) {
+        return TABLE[PairKey(a, b)];
+    }
+
+    inline ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB, PairCache& cache) {
+        return Lookup(a.GetShapeType(), b.GetShapeType())(a, rotA, b, rotB, cache);
+    }
+}
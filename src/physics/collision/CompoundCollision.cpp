@@ -0,0 +1,100 @@
+#include "CompoundCollision.h"
+#include "physics/collision/CollisionDispatch.h"
+#include "physics/collision/ContactReduction.h"
+#include <vector>
+
+namespace {
+    // Keep near-touching pairs as speculative contacts, same as SAT
+    constexpr float CONTACT_THRESHOLD = 0.05f;
+
+    // Stand-in bodies for the current child on each side; one set per thread.
+    // Built without ids, so workers reaching here don't shift later bodies' ids.
+    thread_local RigidBody proxyA(BodyDesc{}, RigidBody::NO_ID);
+    thread_local RigidBody proxyB(BodyDesc{}, RigidBody::NO_ID);
+    // Child pairs start cold, like voxel boxes: their entries can't be made
+    // in the scene's cache mid-narrowphase, and one kept per thread would
+    // warm-start a pair differently depending on which worker ran it.
+    // Emptied before every child pair, so it is only a scratch entry.
+    thread_local PairCache scratch;
+
+    ContactManifold DetectChild(const RigidBody& a, const glm::mat3& rotA,
+                                const RigidBody& b, const glm::mat3& rotB) {
+        scratch.Clear();
+        return CollisionDispatch::Detect(a, rotA, b, rotB, scratch);
+    }
+
+    // Place the proxy on a child and return the child's world rotation
+    glm::mat3 PlaceProxy(RigidBody& proxy, const CompoundChild& child,
+                         const RigidBody& body, const glm::mat3& rot) {
+        std::visit([&](const auto& s) { proxy.shape = s; }, child.shape);
+        proxy.position = body.position + rot * child.position;
+        proxy.orientation = body.orientation * child.orientation;
+        return rot * glm::mat3_cast(child.orientation);
+    }
+
+    // World AABB expressed as a box around it in the body's frame
+    AABB ToLocal(const AABB& world, const RigidBody& body, const glm::mat3& rot) {
+        glm::mat3 invRot = glm::transpose(rot);
+        glm::vec3 center = invRot * ((world.min + world.max) * 0.5f - body.position);
+        glm::vec3 half = (world.max - world.min) * 0.5f + glm::vec3(CONTACT_THRESHOLD);
+        glm::vec3 localHalf = glm::abs(invRot[0]) * half.x + glm::abs(invRot[1]) * half.y + glm::abs(invRot[2]) * half.z;
+        return AABB(center - localHalf, center + localHalf);
+    }
+
+    void Accumulate(const ContactManifold& m, ContactManifold& manifold, std::vector<ContactPoint>& contacts) {
+        if (!m.hasCollision) return;
+        if (!manifold.hasCollision || m.penetration > manifold.penetration) {
+            manifold.hasCollision = true;
+            manifold.normal = m.normal;
+            manifold.penetration = m.penetration;
+        }
+        contacts.insert(contacts.end(), m.contacts.begin(), m.contacts.end());
+    }
+
+    void Finish(ContactManifold& manifold, std::vector<ContactPoint>& contacts) {
+        if (!manifold.hasCollision) return;
+        ContactReduction::Reduce(contacts, manifold.normal);
+        manifold.contacts = std::move(contacts);
+    }
+}
+
+ContactManifold CompoundCollision::Detect(const RigidBody& compound, const glm::mat3& rotCompound,
+                                          const RigidBody& other, const glm::mat3& rotOther) {
+    ContactManifold manifold;
+    manifold.a = (RigidBody*)&compound;
+    manifold.b = (RigidBody*)&other;
+
+    const CompoundData& data = *compound.AsCompound().compound;
+    std::vector<ContactPoint> contacts;
+    // A plane's AABB is unbounded, so every child tests it directly
+    AABB query = other.GetShapeType() == ShapeType::Plane
+        ? AABB(data.boundsMin, data.boundsMax)
+        : ToLocal(other.ComputeAABB(rotOther), compound, rotCompound);
+    data.ForEachChild(query, [&](uint32_t, const CompoundChild& child) {
+        glm::mat3 rotChild = PlaceProxy(proxyA, child, compound, rotCompound);
+        Accumulate(DetectChild(proxyA, rotChild, other, rotOther), manifold, contacts);
+    });
+    Finish(manifold, contacts);
+    return manifold;
+}
+
+ContactManifold CompoundCollision::DetectCompounds(const RigidBody& a, const glm::mat3& rotA,
+                                                   const RigidBody& b, const glm::mat3& rotB) {
+    ContactManifold manifold;
+    manifold.a = (RigidBody*)&a;
+    manifold.b = (RigidBody*)&b;
+
+    const CompoundData& dataB = *b.AsCompound().compound;
+    std::vector<ContactPoint> contacts;
+    AABB query = ToLocal(b.ComputeAABB(rotB), a, rotA);
+    a.AsCompound().compound->ForEachChild(query, [&](uint32_t, const CompoundChild& childA) {
+        glm::mat3 rotChildA = PlaceProxy(proxyA, childA, a, rotA);
+        AABB queryB = ToLocal(proxyA.ComputeAABB(rotChildA), b, rotB);
+        dataB.ForEachChild(queryB, [&](uint32_t, const CompoundChild& childB) {
+            glm::mat3 rotChildB = PlaceProxy(proxyB, childB, b, rotB);
+            Accumulate(DetectChild(proxyA, rotChildA, proxyB, rotChildB), manifold, contacts);
+        });
+    });
+    Finish(manifold, contacts);
+    return manifold;
+}
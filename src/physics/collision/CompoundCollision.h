@@ -0,0 +1,16 @@
+#pragma once
+
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/ContactManifold.h"
+#include "physics/collision/PairCache.h"
+
+// Compound bodies collide as one broadphase entry. Narrowphase walks the
+// compound's BVH with the other body's bounds and runs the regular kernel
+// for each overlapping child; child contacts are pooled into one manifold.
+class CompoundCollision {
+public:
+    static ContactManifold Detect(const RigidBody& compound, const glm::mat3& rotCompound,
+                                  const RigidBody& other, const glm::mat3& rotOther);
+    static ContactManifold DetectCompounds(const RigidBody& a, const glm::mat3& rotA,
+                                           const RigidBody& b, const glm::mat3& rotB);
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+#include "physics/collision/ContactManifold.h"
+
+namespace ContactReduction {
+
+    // Keep the deepest point and the three that span the largest area around it
+    inline void Reduce(std::vector<ContactPoint>& contacts, const glm::vec3& normal, size_t maxContacts = 4) {
+        if (contacts.size() <= maxContacts) return;
+
+        int first = 0;
+        for (int i = 1; i < (int)contacts.size(); i++) {
+            if (contacts[i].penetration > contacts[first].penetration) first = i;
+        }
+        glm::vec3 p0 = contacts[first].point;
+
+        int second = first;
+        float best = -1.0f;
+        for (int i = 0; i < (int)contacts.size(); i++) {
+            float d = glm::length2(contacts[i].point - p0);
+            if (d > best) { best = d; second = i; }
+        }
+        glm::vec3 p1 = contacts[second].point;
+
+        int third = first, fourth = first;
+        float maxArea = 0.0f, minArea = 0.0f;
+        for (int i = 0; i < (int)contacts.size(); i++) {
+            float area = glm::dot(glm::cross(p1 - p0, contacts[i].point - p0), normal);
+            if (area > maxArea) { maxArea = area; third = i; }
+            if (area < minArea) { minArea = area; fourth = i; }
+        }
+
+        std::vector<ContactPoint> kept = {contacts[first], contacts[second]};
+        if (third != first && third != second) kept.push_back(contacts[third]);
+        if (fourth != first && fourth != second && fourth != third) kept.push_back(contacts[fourth]);
+        contacts.swap(kept);
+    }
+}
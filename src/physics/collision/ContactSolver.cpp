@@ -7,6 +7,11 @@
 #include <glm/gtx/string_cast.hpp>
 
 void ContactSolver::Resolve(RigidBody& a, RigidBody& b, const glm::vec3& contactPoint, const glm::vec3& normalInput, float penetration, float deltaTime) {
+    Resolve(a, b, a.inverseInertiaTensor, b.inverseInertiaTensor, contactPoint, normalInput, penetration, deltaTime);
+}
+
+void ContactSolver::Resolve(RigidBody& a, RigidBody& b, const glm::mat3& invInertiaA, const glm::mat3& invInertiaB,
+                            const glm::vec3& contactPoint, const glm::vec3& normalInput, float penetration, float deltaTime) {
     if (penetration <= 0.0f) return;
     if (a.isStatic && b.isStatic) return;
 
@@ -32,8 +37,8 @@ void ContactSolver::Resolve(RigidBody& a, RigidBody& b, const glm::vec3& contact
     glm::vec3 raCrossN = glm::cross(ra, normal);
     glm::vec3 rbCrossN = glm::cross(rb, normal);
 
-    float angularTerm = glm::dot(raCrossN, a.inverseInertiaTensor * raCrossN) +
-                        glm::dot(rbCrossN, b.inverseInertiaTensor * rbCrossN);
+    float angularTerm = glm::dot(raCrossN, invInertiaA * raCrossN) +
+                        glm::dot(rbCrossN, invInertiaB * rbCrossN);
     float invMassSum = invMassA + invMassB + angularTerm;
     if (invMassSum == 0.0f) return;
 
@@ -50,11 +55,11 @@ void ContactSolver::Resolve(RigidBody& a, RigidBody& b, const glm::vec3& contact
 
     if (!a.isStatic) {
         a.velocity -= impulse * invMassA;
-        a.angularVelocity -= a.inverseInertiaTensor * glm::cross(ra, impulse);
+        a.angularVelocity -= invInertiaA * glm::cross(ra, impulse);
     }
     if (!b.isStatic) {
         b.velocity += impulse * invMassB;
-        b.angularVelocity += b.inverseInertiaTensor * glm::cross(rb, impulse);
+        b.angularVelocity += invInertiaB * glm::cross(rb, impulse);
     }
 
     // --- Friction ---
@@ -81,11 +86,11 @@ void ContactSolver::Resolve(RigidBody& a, RigidBody& b, const glm::vec3& contact
 
         if (!a.isStatic) {
             a.velocity -= frictionImpulse * invMassA;
-            a.angularVelocity -= a.inverseInertiaTensor * glm::cross(ra, frictionImpulse);
+            a.angularVelocity -= invInertiaA * glm::cross(ra, frictionImpulse);
         }
         if (!b.isStatic) {
             b.velocity += frictionImpulse * invMassB;
-            b.angularVelocity += b.inverseInertiaTensor * glm::cross(rb, frictionImpulse);
+            b.angularVelocity += invInertiaB * glm::cross(rb, frictionImpulse);
         }
     }
 
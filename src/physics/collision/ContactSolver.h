@@ -8,6 +8,9 @@
 class ContactSolver {
 public:
     void Resolve(RigidBody& a, RigidBody& b, const glm::vec3& contactPoint, const glm::vec3& normalInput, float penetration, float deltaTime);
+    // With world-space inverse inertia from the step's TransformCache
+    void Resolve(RigidBody& a, RigidBody& b, const glm::mat3& invInertiaA, const glm::mat3& invInertiaB,
+                 const glm::vec3& contactPoint, const glm::vec3& normalInput, float penetration, float deltaTime);
     static bool AABBOverlap(const AABB& a, const AABB& b);
 };
 
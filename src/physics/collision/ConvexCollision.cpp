@@ -0,0 +1,51 @@
+#include "ConvexCollision.h"
+#include "physics/collision/GJK.h"
+#include "physics/collision/EPA.h"
+
+namespace {
+    // Keep near-touching pairs as speculative contacts, same as SAT
+    constexpr float CONTACT_THRESHOLD = 0.05f;
+}
+
+ContactManifold ConvexCollision::Detect(const RigidBody& a, const glm::mat3& rotA,
+                                        const RigidBody& b, const glm::mat3& rotB,
+                                        PairCacheEntry& cache) {
+    ContactManifold manifold;
+    manifold.a = (RigidBody*)&a;
+    manifold.b = (RigidBody*)&b;
+
+    ConvexProxy proxyA(a, rotA);
+    ConvexProxy proxyB(b, rotB);
+    GJKResult result = GJK::Distance(proxyA, proxyB, &cache.simplex);
+    float margins = proxyA.margin + proxyB.margin;
+
+    glm::vec3 normal;
+    glm::vec3 pointB;
+    float penetration;
+    if (!result.overlap) {
+        float separation = result.distance - margins;
+        if (separation > CONTACT_THRESHOLD) return manifold;
+        normal = (result.pointB - result.pointA) / result.distance;
+        pointB = result.pointB;
+        penetration = -separation;
+    } else {
+        glm::vec3 pointA;
+        float depth;
+        if (!EPA::Penetration(proxyA, proxyB, result.simplex, normal, depth, pointA, pointB)) {
+            return manifold;
+        }
+        penetration = depth + margins;
+    }
+
+    // Contact sits on B's inflated surface, as in the other kernels
+    ContactPoint cp;
+    cp.point = pointB - normal * proxyB.margin;
+    cp.normal = normal;
+    cp.penetration = penetration;
+    manifold.contacts.push_back(cp);
+
+    manifold.hasCollision = true;
+    manifold.normal = normal;
+    manifold.penetration = penetration;
+    return manifold;
+}
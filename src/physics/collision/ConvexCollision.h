@@ -0,0 +1,15 @@
+#pragma once
+
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/ContactManifold.h"
+#include "physics/collision/PairCache.h"
+
+// Fallback narrowphase for any two ConvexShapes: GJK on the cores, EPA when
+// they overlap. Produces a single contact; pairs that need a full manifold
+// (box-box) keep their dedicated kernel.
+class ConvexCollision {
+public:
+    static ContactManifold Detect(const RigidBody& a, const glm::mat3& rotA,
+                                  const RigidBody& b, const glm::mat3& rotB,
+                                  PairCacheEntry& cache);
+};
@@ -0,0 +1,205 @@
+#include "EPA.h"
+#include "physics/collision/ClosestPoint.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace {
+    constexpr int MAX_ITERATIONS = 64;
+    constexpr float TOLERANCE = 1e-4f;  // Stop once a new support point gains less than this
+    constexpr float CORE_EPSILON = 1e-6f;  // Closer cores than this give no usable normal
+
+    struct Face {
+        int i[3];
+        glm::vec3 n;
+        float d;  // Distance from the origin along n
+    };
+
+    bool MakeFace(const std::vector<SupportPoint>& verts, int i0, int i1, int i2, Face& face) {
+        glm::vec3 n = glm::cross(verts[i1].w - verts[i0].w, verts[i2].w - verts[i0].w);
+        float lengthSq = glm::length2(n);
+        if (lengthSq < 1e-16f) return false;
+        face.i[0] = i0;
+        face.i[1] = i1;
+        face.i[2] = i2;
+        face.n = n / std::sqrt(lengthSq);
+        face.d = glm::dot(face.n, verts[i0].w);
+        return true;
+    }
+
+    void AddEdge(std::vector<std::pair<int, int>>& edges, int from, int to) {
+        for (size_t k = 0; k < edges.size(); k++) {
+            if (edges[k].first == to && edges[k].second == from) {
+                // Shared by two removed faces, so not on the horizon
+                edges[k] = edges.back();
+                edges.pop_back();
+                return;
+            }
+        }
+        edges.emplace_back(from, to);
+    }
+}
+
+bool EPA::BuildTetrahedron(const ConvexProxy& a, const ConvexProxy& b, Simplex& s) {
+    static const glm::vec3 AXES[6] = {
+        {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1},
+    };
+
+    if (s.count == 1) {
+        for (const glm::vec3& axis : AXES) {
+            SupportPoint p = GJK::Support(a, b, axis);
+            if (glm::length2(p.w - s.v[0].w) > 1e-10f) {
+                s.v[s.count++] = p;
+                break;
+            }
+        }
+        if (s.count < 2) return false;
+    }
+
+    if (s.count == 2) {
+        glm::vec3 ab = s.v[1].w - s.v[0].w;
+        glm::vec3 e = std::abs(ab.x) < std::abs(ab.y) ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+        glm::vec3 perp = glm::cross(ab, e);
+        glm::vec3 dirs[4] = {perp, -perp, glm::cross(ab, perp), -glm::cross(ab, perp)};
+        for (const glm::vec3& dir : dirs) {
+            SupportPoint p = GJK::Support(a, b, dir);
+            if (glm::length2(glm::cross(p.w - s.v[0].w, ab)) > 1e-10f) {
+                s.v[s.count++] = p;
+                break;
+            }
+        }
+        if (s.count < 3) return false;
+    }
+
+    if (s.count == 3) {
+        glm::vec3 n = glm::cross(s.v[1].w - s.v[0].w, s.v[2].w - s.v[0].w);
+        for (const glm::vec3& dir : {n, -n}) {
+            SupportPoint p = GJK::Support(a, b, dir);
+            if (std::abs(glm::dot(p.w - s.v[0].w, n)) > 1e-8f) {
+                s.v[s.count++] = p;
+                break;
+            }
+        }
+        if (s.count < 4) return false;
+    }
+    return true;
+}
+
+bool EPA::ClosestCores(const ConvexProxy& a, const ConvexProxy& b,
+                       glm::vec3& normal, float& depth, glm::vec3& pointA, glm::vec3& pointB) {
+    glm::vec3 p1, q1, p2, q2;
+    if (!a.CoreSegment(p1, q1) || !b.CoreSegment(p2, q2)) return false;
+
+    ClosestPoint::Segments(p1, q1, p2, q2, pointA, pointB);
+    glm::vec3 delta = pointB - pointA;
+    float distance = glm::length(delta);
+    if (distance > CORE_EPSILON) {
+        normal = delta / distance;
+    } else {
+        // Cores cross or lie along each other: push out across both of them,
+        // else sideways from the longer one towards B's center
+        glm::vec3 d1 = q1 - p1, d2 = q2 - p2;
+        glm::vec3 n = glm::cross(d1, d2);
+        if (glm::length2(n) < 1e-12f) {
+            glm::vec3 axis = glm::length2(d1) > glm::length2(d2) ? d1 : d2;
+            glm::vec3 offset = b.position - a.position;
+            n = glm::length2(axis) > 1e-12f ? offset - axis * (glm::dot(offset, axis) / glm::length2(axis)) : offset;
+            if (glm::length2(n) < 1e-12f) {
+                // Same center too; any direction off the axis will do
+                glm::vec3 e = std::abs(axis.x) < std::abs(axis.y) ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+                n = glm::length2(axis) > 1e-12f ? glm::cross(axis, e) : glm::vec3(0, 1, 0);
+            }
+        }
+        normal = glm::normalize(n);
+        if (glm::dot(normal, b.position - a.position) < 0.0f) normal = -normal;
+    }
+    // The margins overlap by their sum minus the core distance
+    depth = -distance;
+    return true;
+}
+
+bool EPA::Penetration(const ConvexProxy& a, const ConvexProxy& b, const Simplex& simplex,
+                      glm::vec3& normal, float& depth, glm::vec3& pointA, glm::vec3& pointB) {
+    Simplex s = simplex;
+    if (!BuildTetrahedron(a, b, s)) return ClosestCores(a, b, normal, depth, pointA, pointB);
+
+    std::vector<SupportPoint> verts(s.v, s.v + 4);
+    std::vector<Face> faces;
+    faces.reserve(32);
+
+    // Wind the tetrahedron so every face points away from the opposite vertex
+    static const int TETRA[4][4] = {{0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}};
+    for (const int* t : TETRA) {
+        Face face;
+        if (!MakeFace(verts, t[0], t[1], t[2], face)) return ClosestCores(a, b, normal, depth, pointA, pointB);
+        if (glm::dot(face.n, verts[t[3]].w - verts[t[0]].w) > 0.0f) {
+            MakeFace(verts, t[0], t[2], t[1], face);
+        }
+        faces.push_back(face);
+    }
+
+    std::vector<std::pair<int, int>> horizon;
+    int closest = 0;
+    for (int iter = 0; iter < MAX_ITERATIONS; iter++) {
+        closest = 0;
+        for (int f = 1; f < (int)faces.size(); f++) {
+            if (faces[f].d < faces[closest].d) closest = f;
+        }
+
+        Face face = faces[closest];
+        SupportPoint p = GJK::Support(a, b, face.n);
+        if (glm::dot(p.w, face.n) - face.d < TOLERANCE) break;
+
+        int index = (int)verts.size();
+        verts.push_back(p);
+
+        // Remove every face the new point can see and keep the boundary loop
+        horizon.clear();
+        for (size_t f = 0; f < faces.size();) {
+            if (glm::dot(faces[f].n, p.w - verts[faces[f].i[0]].w) > 0.0f) {
+                AddEdge(horizon, faces[f].i[0], faces[f].i[1]);
+                AddEdge(horizon, faces[f].i[1], faces[f].i[2]);
+                AddEdge(horizon, faces[f].i[2], faces[f].i[0]);
+                faces[f] = faces.back();
+                faces.pop_back();
+            } else {
+                ++f;
+            }
+        }
+
+        for (const auto& edge : horizon) {
+            Face newFace;
+            if (MakeFace(verts, edge.first, edge.second, index, newFace)) faces.push_back(newFace);
+        }
+        if (faces.empty()) return ClosestCores(a, b, normal, depth, pointA, pointB);
+        closest = 0;
+        for (int f = 1; f < (int)faces.size(); f++) {
+            if (faces[f].d < faces[closest].d) closest = f;
+        }
+    }
+
+    // Witness points from the origin's projection onto the closest face
+    const Face& face = faces[closest];
+    const SupportPoint& v0 = verts[face.i[0]];
+    const SupportPoint& v1 = verts[face.i[1]];
+    const SupportPoint& v2 = verts[face.i[2]];
+    glm::vec3 q = face.n * face.d;
+    glm::vec3 e0 = v1.w - v0.w, e1 = v2.w - v0.w, e2 = q - v0.w;
+    float d00 = glm::dot(e0, e0), d01 = glm::dot(e0, e1), d11 = glm::dot(e1, e1);
+    float d20 = glm::dot(e2, e0), d21 = glm::dot(e2, e1);
+    float denom = d00 * d11 - d01 * d01;
+    float u = 1.0f / 3.0f, v = 1.0f / 3.0f;
+    if (std::abs(denom) > 1e-12f) {
+        u = (d11 * d20 - d01 * d21) / denom;
+        v = (d00 * d21 - d01 * d20) / denom;
+    }
+    float w0 = 1.0f - u - v;
+
+    normal = face.n;
+    depth = face.d;
+    pointA = v0.a * w0 + v1.a * u + v2.a * v;
+    pointB = v0.b * w0 + v1.b * u + v2.b * v;
+    return true;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include "physics/collision/GJK.h"
+
+// Expanding polytope: penetration depth of two overlapping cores, seeded
+// with the simplex GJK ended on.
+class EPA {
+public:
+    // normal points from A to B; depth excludes the margins
+    static bool Penetration(const ConvexProxy& a, const ConvexProxy& b, const Simplex& simplex,
+                            glm::vec3& normal, float& depth, glm::vec3& pointA, glm::vec3& pointB);
+
+private:
+    // Grow a degenerate GJK simplex into a tetrahedron enclosing the origin
+    static bool BuildTetrahedron(const ConvexProxy& a, const ConvexProxy& b, Simplex& s);
+    // For a flat or linear difference, where there is no polytope to expand:
+    // closest features of two point or segment cores
+    static bool ClosestCores(const ConvexProxy& a, const ConvexProxy& b,
+                             glm::vec3& normal, float& depth, glm::vec3& pointA, glm::vec3& pointB);
+};
@@ -0,0 +1,305 @@
+#include "GJK.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+#include <cfloat>
+
+namespace {
+    constexpr int MAX_ITERATIONS = 32;
+    constexpr float TOUCH_EPSILON_SQ = 1e-10f;  // Cores this close count as overlapping
+    constexpr float CONVERGENCE_TOLERANCE = 1e-5f;  // Relative progress below which we stop
+
+    // Keep only the listed vertices, in order, with the given weights
+    void Reduce(Simplex& s, int count, const int* keep, const float* bary) {
+        SupportPoint kept[4];
+        for (int i = 0; i < count; i++) kept[i] = s.v[keep[i]];
+        for (int i = 0; i < count; i++) {
+            s.v[i] = kept[i];
+            s.bary[i] = bary[i];
+        }
+        s.count = count;
+    }
+
+    // True if the origin is on the other side of plane (a, b, c) from d.
+    // A flat tetrahedron reports every face as outside so its triangles get checked.
+    bool OriginOutsideFace(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d) {
+        glm::vec3 n = glm::cross(b - a, c - a);
+        float signOrigin = glm::dot(-a, n);
+        float signD = glm::dot(d - a, n);
+        if (signD * signD < 1e-12f * glm::length2(n)) return true;
+        return signOrigin * signD < 0.0f;
+    }
+}
+
+ConvexProxy::ConvexProxy(const RigidBody& body, const glm::mat3& rot)
+    : ConvexProxy(body.shape, body.position, rot) {}
+
+ConvexProxy::ConvexProxy(const Shape& shape, const glm::vec3& position, const glm::mat3& rot)
+    : shape(&shape), position(position), rot(rot) {
+    margin = std::visit([](const auto& s) {
+        if constexpr (ConvexShape<std::decay_t<decltype(s)>>) return s.GetMargin();
+        else return 0.0f;
+    }, shape);
+}
+
+ConvexProxy::ConvexProxy(const glm::vec3* points, int pointCount, const glm::vec3& position, const glm::mat3& rot)
+    : shape(nullptr), points(points), pointCount(pointCount), position(position), rot(rot), margin(0.0f) {}
+
+glm::vec3 ConvexProxy::SupportLocal(const glm::vec3& localDir) const {
+    if (points) {
+        int best = 0;
+        float bestDot = glm::dot(points[0], localDir);
+        for (int i = 1; i < pointCount; i++) {
+            float d = glm::dot(points[i], localDir);
+            if (d > bestDot) {
+                bestDot = d;
+                best = i;
+            }
+        }
+        return points[best];
+    }
+    return std::visit([&](const auto& s) {
+        if constexpr (ConvexShape<std::decay_t<decltype(s)>>) return glm::vec3(s.Support(localDir));
+        else return glm::vec3(0.0f);  // Never dispatched to GJK
+    }, *shape);
+}
+
+bool ConvexProxy::CoreSegment(glm::vec3& p, glm::vec3& q) const {
+    if (points) {
+        if (pointCount > 2) return false;
+        p = ToWorld(points[0]);
+        q = ToWorld(points[pointCount - 1]);
+        return true;
+    }
+    if (const CapsuleShape* capsule = std::get_if<CapsuleShape>(shape)) {
+        p = ToWorld(glm::vec3(0.0f, -capsule->halfHeight, 0.0f));
+        q = ToWorld(glm::vec3(0.0f, capsule->halfHeight, 0.0f));
+        return true;
+    }
+    if (std::holds_alternative<SphereShape>(*shape)) {
+        p = q = position;
+        return true;
+    }
+    return false;
+}
+
+SupportPoint GJK::Support(const ConvexProxy& a, const ConvexProxy& b, const glm::vec3& dir) {
+    SupportPoint p;
+    p.localA = a.SupportLocal(a.ToLocalDir(dir));
+    p.localB = b.SupportLocal(b.ToLocalDir(-dir));
+    p.a = a.ToWorld(p.localA);
+    p.b = b.ToWorld(p.localB);
+    p.w = p.a - p.b;
+    return p;
+}
+
+GJKResult GJK::Distance(const ConvexProxy& a, const ConvexProxy& b, SimplexCache* cache) {
+    GJKResult result;
+    Simplex& s = result.simplex;
+
+    // Warm start: re-evaluate last frame's support points at the current poses
+    if (cache && cache->count > 0) {
+        for (int i = 0; i < cache->count; i++) {
+            SupportPoint& p = s.v[i];
+            p.localA = cache->localA[i];
+            p.localB = cache->localB[i];
+            p.a = a.ToWorld(p.localA);
+            p.b = b.ToWorld(p.localB);
+            p.w = p.a - p.b;
+        }
+        s.count = cache->count;
+    } else {
+        glm::vec3 dir = b.position - a.position;
+        if (glm::length2(dir) < 1e-12f) dir = glm::vec3(1.0f, 0.0f, 0.0f);
+        s.v[0] = Support(a, b, -dir);
+        s.count = 1;
+    }
+
+    glm::vec3 v(0.0f);
+    float distSq = FLT_MAX;
+    for (result.iterations = 0; result.iterations < MAX_ITERATIONS; result.iterations++) {
+        v = Solve(s);
+        if (s.count == 4) {
+            result.overlap = true;
+            break;
+        }
+
+        float newDistSq = glm::length2(v);
+        if (newDistSq < TOUCH_EPSILON_SQ) {
+            result.overlap = true;
+            break;
+        }
+        if (newDistSq >= distSq) break;  // No progress left in float precision
+        distSq = newDistSq;
+
+        SupportPoint p = Support(a, b, -v);
+        if (distSq - glm::dot(v, p.w) <= CONVERGENCE_TOLERANCE * distSq) break;
+
+        bool duplicate = false;
+        for (int i = 0; i < s.count; i++) {
+            if (glm::length2(s.v[i].w - p.w) < 1e-12f) duplicate = true;
+        }
+        if (duplicate) break;
+
+        s.v[s.count++] = p;
+    }
+
+    if (!result.overlap) {
+        result.pointA = glm::vec3(0.0f);
+        result.pointB = glm::vec3(0.0f);
+        for (int i = 0; i < s.count; i++) {
+            result.pointA += s.v[i].a * s.bary[i];
+            result.pointB += s.v[i].b * s.bary[i];
+        }
+        result.distance = glm::length(result.pointA - result.pointB);
+    }
+
+    if (cache) {
+        cache->count = s.count;
+        for (int i = 0; i < s.count; i++) {
+            cache->localA[i] = s.v[i].localA;
+            cache->localB[i] = s.v[i].localB;
+        }
+    }
+    return result;
+}
+
+glm::vec3 GJK::Solve(Simplex& s) {
+    switch (s.count) {
+        case 1:
+            s.bary[0] = 1.0f;
+            return s.v[0].w;
+        case 2:
+            return SolveSegment(s);
+        case 3:
+            return SolveTriangle(s);
+        default:
+            return SolveTetrahedron(s);
+    }
+}
+
+glm::vec3 GJK::SolveSegment(Simplex& s) {
+    glm::vec3 a = s.v[0].w;
+    glm::vec3 ab = s.v[1].w - a;
+    float lengthSq = glm::length2(ab);
+    float t = lengthSq > 0.0f ? glm::dot(-a, ab) / lengthSq : 0.0f;
+
+    if (t <= 0.0f) {
+        int keep[] = {0};
+        float bary[] = {1.0f};
+        Reduce(s, 1, keep, bary);
+        return s.v[0].w;
+    }
+    if (t >= 1.0f) {
+        int keep[] = {1};
+        float bary[] = {1.0f};
+        Reduce(s, 1, keep, bary);
+        return s.v[0].w;
+    }
+    s.bary[0] = 1.0f - t;
+    s.bary[1] = t;
+    return a + ab * t;
+}
+
+// Voronoi region tests from Ericson's closest point on triangle
+glm::vec3 GJK::SolveTriangle(Simplex& s) {
+    glm::vec3 a = s.v[0].w, b = s.v[1].w, c = s.v[2].w;
+    glm::vec3 ab = b - a, ac = c - a;
+
+    float d1 = glm::dot(ab, -a);
+    float d2 = glm::dot(ac, -a);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        int keep[] = {0};
+        float bary[] = {1.0f};
+        Reduce(s, 1, keep, bary);
+        return a;
+    }
+
+    float d3 = glm::dot(ab, -b);
+    float d4 = glm::dot(ac, -b);
+    if (d3 >= 0.0f && d4 <= d3) {
+        int keep[] = {1};
+        float bary[] = {1.0f};
+        Reduce(s, 1, keep, bary);
+        return b;
+    }
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        float t = d1 / (d1 - d3);
+        int keep[] = {0, 1};
+        float bary[] = {1.0f - t, t};
+        Reduce(s, 2, keep, bary);
+        return a + ab * t;
+    }
+
+    float d5 = glm::dot(ab, -c);
+    float d6 = glm::dot(ac, -c);
+    if (d6 >= 0.0f && d5 <= d6) {
+        int keep[] = {2};
+        float bary[] = {1.0f};
+        Reduce(s, 1, keep, bary);
+        return c;
+    }
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        float t = d2 / (d2 - d6);
+        int keep[] = {0, 2};
+        float bary[] = {1.0f - t, t};
+        Reduce(s, 2, keep, bary);
+        return a + ac * t;
+    }
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        int keep[] = {1, 2};
+        float bary[] = {1.0f - t, t};
+        Reduce(s, 2, keep, bary);
+        return b + (c - b) * t;
+    }
+
+    float denom = 1.0f / (va + vb + vc);
+    float v = vb * denom;
+    float w = vc * denom;
+    s.bary[0] = 1.0f - v - w;
+    s.bary[1] = v;
+    s.bary[2] = w;
+    return a + ab * v + ac * w;
+}
+
+glm::vec3 GJK::SolveTetrahedron(Simplex& s) {
+    static const int FACES[4][4] = {
+        {0, 1, 2, 3},
+        {0, 2, 3, 1},
+        {0, 3, 1, 2},
+        {1, 3, 2, 0},
+    };
+
+    Simplex best;
+    glm::vec3 bestPoint(0.0f);
+    float bestDistSq = FLT_MAX;
+    bool outside = false;
+
+    for (const int* f : FACES) {
+        if (!OriginOutsideFace(s.v[f[0]].w, s.v[f[1]].w, s.v[f[2]].w, s.v[f[3]].w)) continue;
+        outside = true;
+
+        Simplex face;
+        face.v[0] = s.v[f[0]];
+        face.v[1] = s.v[f[1]];
+        face.v[2] = s.v[f[2]];
+        face.count = 3;
+        glm::vec3 point = SolveTriangle(face);
+        float distSq = glm::length2(point);
+        if (distSq < bestDistSq) {
+            bestDistSq = distSq;
+            bestPoint = point;
+            best = face;
+        }
+    }
+
+    if (!outside) return glm::vec3(0.0f);  // Origin enclosed, count stays 4
+    s = best;
+    return bestPoint;
+}
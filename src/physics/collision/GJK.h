@@ -0,0 +1,71 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/PairCache.h"
+
+// A convex body as GJK sees it: the core shape's support mapping in world
+// space, plus the margin (sphere/capsule radius) the core is inflated by.
+class ConvexProxy {
+public:
+    ConvexProxy(const RigidBody& body, const glm::mat3& rot);
+    ConvexProxy(const Shape& shape, const glm::vec3& position, const glm::mat3& rot);
+    // Bare point set with no margin, e.g. a mesh triangle or a ray origin.
+    // The points must outlive the proxy.
+    ConvexProxy(const glm::vec3* points, int pointCount, const glm::vec3& position, const glm::mat3& rot);
+
+    glm::vec3 SupportLocal(const glm::vec3& localDir) const;
+    glm::vec3 ToWorld(const glm::vec3& localPoint) const { return position + rot * localPoint; }
+    glm::vec3 ToLocalDir(const glm::vec3& worldDir) const { return glm::transpose(rot) * worldDir; }
+    // World endpoints when the core is a point or a segment (sphere, capsule,
+    // one or two points); false for cores with volume or area
+    bool CoreSegment(glm::vec3& p, glm::vec3& q) const;
+
+    const Shape* shape;
+    const glm::vec3* points = nullptr;  // Used instead of shape when set
+    int pointCount = 0;
+    glm::vec3 position;
+    glm::mat3 rot;
+    float margin;
+};
+
+// Vertex of the Minkowski difference A - B, with the points that produced it
+struct SupportPoint {
+    glm::vec3 w;
+    glm::vec3 a;
+    glm::vec3 b;
+    glm::vec3 localA;
+    glm::vec3 localB;
+};
+
+struct Simplex {
+    SupportPoint v[4];
+    float bary[4];
+    int count = 0;
+};
+
+struct GJKResult {
+    bool overlap = false;    // Cores intersect (or touch); run EPA for depth
+    float distance = 0.0f;   // Core-to-core distance, margins not included
+    glm::vec3 pointA;        // Closest points on the cores
+    glm::vec3 pointB;
+    int iterations = 0;
+    Simplex simplex;
+};
+
+class GJK {
+public:
+    // Distance between the cores. With a cache the search starts from last
+    // frame's simplex, which usually converges in one or two iterations for
+    // resting contacts; the cache is updated on return.
+    static GJKResult Distance(const ConvexProxy& a, const ConvexProxy& b, SimplexCache* cache);
+
+    static SupportPoint Support(const ConvexProxy& a, const ConvexProxy& b, const glm::vec3& dir);
+
+private:
+    // Reduce the simplex to the smallest feature closest to the origin; returns that point
+    static glm::vec3 Solve(Simplex& s);
+    static glm::vec3 SolveSegment(Simplex& s);
+    static glm::vec3 SolveTriangle(Simplex& s);
+    static glm::vec3 SolveTetrahedron(Simplex& s);
+};
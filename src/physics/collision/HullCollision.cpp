@@ -0,0 +1,252 @@
+#include "HullCollision.h"
+#include "physics/collision/ClosestPoint.h"
+#include "physics/collision/ContactReduction.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+namespace {
+    // Keep near-touching pairs as speculative contacts, same as SAT
+    constexpr float CONTACT_THRESHOLD = 0.05f;
+    // Prefer A's faces, then B's, then edges unless they're clearly better.
+    // Stops the feature choice flickering frame to frame.
+    constexpr float RELATIVE_TOLERANCE = 0.95f;
+    constexpr float ABSOLUTE_TOLERANCE = 0.005f;
+
+    // A box as a hull: the unit box's topology, rescaled in place in a copy
+    // owned by this thread, so hull-box pairs take no lock and allocate
+    // nothing. Collision only reads the geometry, so mass properties are left.
+    const HullData& BoxHull(const glm::vec3& halfExtents) {
+        static const std::shared_ptr<const HullData> unit = HullData::MakeBox(glm::vec3(1.0f));
+        thread_local HullData box = *unit;
+        thread_local glm::vec3 extents(1.0f);
+        if (halfExtents == extents) return box;
+
+        extents = halfExtents;
+        for (size_t i = 0; i < box.vertices.size(); i++) {
+            box.vertices[i] = unit->vertices[i] * halfExtents;
+        }
+        for (size_t i = 0; i < box.faces.size(); i++) {
+            HullFace& face = box.faces[i];
+            face.normal = glm::normalize(unit->faces[i].normal / halfExtents);
+            face.offset = glm::dot(face.normal, box.vertices[box.edges[face.edge].origin]);
+        }
+        box.boundsMin = unit->boundsMin * halfExtents;
+        box.boundsMax = unit->boundsMax * halfExtents;
+        return box;
+    }
+
+    // Pose of the other hull expressed in this hull's local frame
+    struct Relative {
+        glm::mat3 rot;
+        glm::vec3 pos;
+        glm::vec3 Point(const glm::vec3& p) const { return rot * p + pos; }
+    };
+
+    struct FaceQuery {
+        int face = -1;
+        float separation = -FLT_MAX;
+    };
+
+    struct EdgeQuery {
+        int edgeA = -1;
+        int edgeB = -1;
+        float separation = -FLT_MAX;
+        glm::vec3 normal;
+    };
+
+    FaceQuery QueryFaces(const HullData& hull, const HullData& other, const Relative& otherPose) {
+        FaceQuery query;
+        glm::mat3 toOther = glm::transpose(otherPose.rot);
+        for (int f = 0; f < (int)hull.faces.size(); f++) {
+            const HullFace& face = hull.faces[f];
+            glm::vec3 deepest = otherPose.Point(other.Support(toOther * -face.normal));
+            float separation = glm::dot(face.normal, deepest) - face.offset;
+            if (separation > query.separation) {
+                query.separation = separation;
+                query.face = f;
+            }
+        }
+        return query;
+    }
+
+    // Arcs a-b and c-d cross on the unit sphere; c and d are already negated
+    bool IsMinkowskiFace(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d) {
+        glm::vec3 bxa = glm::cross(b, a);
+        glm::vec3 dxc = glm::cross(d, c);
+        float cba = glm::dot(c, bxa);
+        float dba = glm::dot(d, bxa);
+        float adc = glm::dot(a, dxc);
+        float bdc = glm::dot(b, dxc);
+        return cba * dba < 0.0f && adc * bdc < 0.0f && cba * bdc > 0.0f;
+    }
+
+    // Everything in A's local frame; B's pose given relative to A
+    EdgeQuery QueryEdges(const HullData& hullA, const HullData& hullB, const Relative& poseB) {
+        EdgeQuery query;
+
+        // Twin pairs share a slot, so only even edges are distinct
+        for (int eA = 0; eA < (int)hullA.edges.size(); eA += 2) {
+            const HullHalfEdge& edgeA = hullA.edges[eA];
+            const HullHalfEdge& twinA = hullA.edges[eA + 1];
+            glm::vec3 p1 = hullA.vertices[edgeA.origin];
+            glm::vec3 q1 = hullA.vertices[twinA.origin];
+            glm::vec3 a = hullA.faces[edgeA.face].normal;
+            glm::vec3 b = hullA.faces[twinA.face].normal;
+
+            for (int eB = 0; eB < (int)hullB.edges.size(); eB += 2) {
+                const HullHalfEdge& edgeB = hullB.edges[eB];
+                const HullHalfEdge& twinB = hullB.edges[eB + 1];
+                glm::vec3 c = poseB.rot * hullB.faces[edgeB.face].normal;
+                glm::vec3 d = poseB.rot * hullB.faces[twinB.face].normal;
+                if (!IsMinkowskiFace(a, b, -c, -d)) continue;
+
+                glm::vec3 p2 = poseB.Point(hullB.vertices[edgeB.origin]);
+                glm::vec3 q2 = poseB.Point(hullB.vertices[twinB.origin]);
+                glm::vec3 e1 = q1 - p1;
+                glm::vec3 e2 = q2 - p2;
+                glm::vec3 n = glm::cross(e1, e2);
+                float lengthSq = glm::length2(n);
+                if (lengthSq < 1e-10f * glm::length2(e1) * glm::length2(e2)) continue;  // Parallel
+
+                n /= std::sqrt(lengthSq);
+                if (glm::dot(n, p1) < 0.0f) n = -n;  // Point away from A's center (the origin)
+                float separation = glm::dot(n, p2 - p1);
+                if (separation > query.separation) {
+                    query.separation = separation;
+                    query.edgeA = eA;
+                    query.edgeB = eB;
+                    query.normal = n;
+                }
+            }
+        }
+        return query;
+    }
+}
+
+ContactManifold HullCollision::DetectHulls(const RigidBody& a, const glm::mat3& rotA,
+                                           const RigidBody& b, const glm::mat3& rotB) {
+    return Collide(a, *a.AsHull().hull, rotA, b, *b.AsHull().hull, rotB);
+}
+
+ContactManifold HullCollision::DetectHullBox(const RigidBody& hull, const glm::mat3& rotHull,
+                                             const RigidBody& box, const glm::mat3& rotBox) {
+    return Collide(hull, *hull.AsHull().hull, rotHull, box, BoxHull(box.AsBox().halfExtents), rotBox);
+}
+
+ContactManifold HullCollision::Collide(const RigidBody& a, const HullData& hullA, const glm::mat3& rotA,
+                                       const RigidBody& b, const HullData& hullB, const glm::mat3& rotB) {
+    ContactManifold manifold;
+    manifold.a = (RigidBody*)&a;
+    manifold.b = (RigidBody*)&b;
+
+    glm::mat3 invRotA = glm::transpose(rotA);
+    glm::mat3 invRotB = glm::transpose(rotB);
+    Relative bInA{invRotA * rotB, invRotA * (b.position - a.position)};
+    Relative aInB{invRotB * rotA, invRotB * (a.position - b.position)};
+
+    FaceQuery faceA = QueryFaces(hullA, hullB, bInA);
+    if (faceA.separation > CONTACT_THRESHOLD) return manifold;
+    FaceQuery faceB = QueryFaces(hullB, hullA, aInB);
+    if (faceB.separation > CONTACT_THRESHOLD) return manifold;
+    EdgeQuery edge = QueryEdges(hullA, hullB, bInA);
+    if (edge.separation > CONTACT_THRESHOLD) return manifold;
+
+    float faceSeparation = std::max(faceA.separation, faceB.separation);
+    if (edge.edgeA >= 0 && edge.separation > RELATIVE_TOLERANCE * faceSeparation + ABSOLUTE_TOLERANCE) {
+        glm::vec3 p1 = hullA.vertices[hullA.edges[edge.edgeA].origin];
+        glm::vec3 q1 = hullA.vertices[hullA.edges[edge.edgeA + 1].origin];
+        glm::vec3 p2 = bInA.Point(hullB.vertices[hullB.edges[edge.edgeB].origin]);
+        glm::vec3 q2 = bInA.Point(hullB.vertices[hullB.edges[edge.edgeB + 1].origin]);
+        glm::vec3 onA, onB;
+        ClosestPoint::Segments(p1, q1, p2, q2, onA, onB);
+
+        glm::vec3 normal = rotA * edge.normal;
+        ContactPoint cp;
+        cp.point = a.position + rotA * onB;
+        cp.normal = normal;
+        cp.penetration = -edge.separation;
+        manifold.contacts.push_back(cp);
+        manifold.hasCollision = true;
+        manifold.normal = normal;
+        manifold.penetration = cp.penetration;
+        return manifold;
+    }
+
+    // Face contact: clip the most anti-parallel face of the other hull
+    // against the side planes of the reference face, in world space
+    bool referenceIsA = faceB.separation <= RELATIVE_TOLERANCE * faceA.separation + ABSOLUTE_TOLERANCE;
+    const HullData& refHull = referenceIsA ? hullA : hullB;
+    const HullData& incHull = referenceIsA ? hullB : hullA;
+    const RigidBody& refBody = referenceIsA ? a : b;
+    const RigidBody& incBody = referenceIsA ? b : a;
+    const glm::mat3& refRot = referenceIsA ? rotA : rotB;
+    const glm::mat3& incRot = referenceIsA ? rotB : rotA;
+    const HullFace& refFace = refHull.faces[referenceIsA ? faceA.face : faceB.face];
+
+    glm::vec3 refNormal = refRot * refFace.normal;
+    float refOffset = refFace.offset + glm::dot(refNormal, refBody.position);
+
+    int incident = 0;
+    float minDot = FLT_MAX;
+    glm::vec3 refNormalInInc = glm::transpose(incRot) * refNormal;
+    for (int f = 0; f < (int)incHull.faces.size(); f++) {
+        float d = glm::dot(incHull.faces[f].normal, refNormalInInc);
+        if (d < minDot) { minDot = d; incident = f; }
+    }
+
+    std::vector<glm::vec3> polygon;
+    uint16_t start = incHull.faces[incident].edge;
+    uint16_t e = start;
+    do {
+        polygon.push_back(incBody.position + incRot * incHull.vertices[incHull.edges[e].origin]);
+        e = incHull.edges[e].next;
+    } while (e != start);
+
+    std::vector<glm::vec3> clipped;
+    start = refFace.edge;
+    e = start;
+    do {
+        glm::vec3 p = refBody.position + refRot * refHull.vertices[refHull.edges[e].origin];
+        glm::vec3 q = refBody.position + refRot * refHull.vertices[refHull.edges[refHull.edges[e].next].origin];
+        glm::vec3 sideNormal = glm::cross(q - p, refNormal);
+        float sideOffset = glm::dot(sideNormal, p);
+
+        // Sutherland-Hodgman against one side plane
+        clipped.clear();
+        for (size_t i = 0; i < polygon.size(); i++) {
+            const glm::vec3& v0 = polygon[i];
+            const glm::vec3& v1 = polygon[(i + 1) % polygon.size()];
+            float d0 = glm::dot(sideNormal, v0) - sideOffset;
+            float d1 = glm::dot(sideNormal, v1) - sideOffset;
+            if (d0 <= 0.0f) clipped.push_back(v0);
+            if ((d0 < 0.0f && d1 > 0.0f) || (d0 > 0.0f && d1 < 0.0f)) {
+                clipped.push_back(v0 + (v1 - v0) * (d0 / (d0 - d1)));
+            }
+        }
+        polygon.swap(clipped);
+        if (polygon.empty()) return manifold;
+        e = refHull.edges[e].next;
+    } while (e != start);
+
+    glm::vec3 normal = referenceIsA ? refNormal : -refNormal;
+    for (const glm::vec3& p : polygon) {
+        float separation = glm::dot(refNormal, p) - refOffset;
+        if (separation > CONTACT_THRESHOLD) continue;
+
+        ContactPoint cp;
+        // Incident points already sit on B when A is the reference; otherwise project onto B's face
+        cp.point = referenceIsA ? p : p - refNormal * separation;
+        cp.normal = normal;
+        cp.penetration = -separation;
+        manifold.contacts.push_back(cp);
+    }
+    ContactReduction::Reduce(manifold.contacts, normal);
+
+    manifold.hasCollision = !manifold.contacts.empty();
+    manifold.normal = normal;
+    manifold.penetration = -std::max(faceA.separation, faceB.separation);
+    return manifold;
+}
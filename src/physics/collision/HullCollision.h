@@ -0,0 +1,21 @@
+#pragma once
+
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/ContactManifold.h"
+#include "physics/shapes/HullData.h"
+
+// SAT between half-edge polytopes. Face axes use the hull's support
+// mapping, edge pairs are only tested when their arcs cross on the Gauss
+// map (i.e. they build a face of the Minkowski difference). Normal points
+// from A to B, contact points lie on B's surface.
+class HullCollision {
+public:
+    static ContactManifold DetectHulls(const RigidBody& a, const glm::mat3& rotA,
+                                       const RigidBody& b, const glm::mat3& rotB);
+    static ContactManifold DetectHullBox(const RigidBody& hull, const glm::mat3& rotHull,
+                                         const RigidBody& box, const glm::mat3& rotBox);
+
+private:
+    static ContactManifold Collide(const RigidBody& a, const HullData& hullA, const glm::mat3& rotA,
+                                   const RigidBody& b, const HullData& hullB, const glm::mat3& rotB);
+};
@@ -0,0 +1,446 @@
+#include "MeshCollision.h"
+#include "physics/collision/ClosestPoint.h"
+#include "physics/collision/ContactReduction.h"
+#include "physics/collision/EPA.h"
+#include "physics/collision/GJK.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+namespace {
+    // Keep near-touching pairs as speculative contacts, same as SAT
+    constexpr float CONTACT_THRESHOLD = 0.05f;
+    // Edge axes must beat face axes by this much, which keeps boxes sliding
+    // across flat ground from snagging on internal edges
+    constexpr float FEATURE_TOLERANCE = 0.005f;
+    constexpr float DUPLICATE_DISTANCE_SQ = 1e-6f;
+    // GJK normals this close to the face normal take the face patch instead
+    constexpr float FACE_ALIGNMENT = 0.999f;
+
+    // Reused across calls; one buffer per thread
+    thread_local std::vector<uint32_t> candidates;
+
+    struct LocalBox {
+        glm::vec3 center;
+        glm::mat3 axes;
+        glm::vec3 half;
+    };
+
+    enum class Feature { None, TriangleFace, BoxFace, EdgeEdge };
+
+    struct AxisResult {
+        Feature feature = Feature::None;
+        float depth = FLT_MAX;
+        glm::vec3 direction;  // From the triangle towards the box
+        int boxIndex = -1;
+        int triIndex = -1;
+    };
+
+    void AddContact(std::vector<ContactPoint>& contacts, const glm::vec3& point,
+                    const glm::vec3& normal, float penetration) {
+        for (const ContactPoint& cp : contacts) {
+            if (glm::length2(cp.point - point) < DUPLICATE_DISTANCE_SQ) return;  // Shared edge or vertex
+        }
+        contacts.push_back({point, normal, penetration});
+    }
+
+    // Sutherland-Hodgman against dot(normal, p) <= offset
+    void ClipPolygon(std::vector<glm::vec3>& polygon, std::vector<glm::vec3>& scratch,
+                     const glm::vec3& normal, float offset) {
+        scratch.clear();
+        for (size_t i = 0; i < polygon.size(); i++) {
+            const glm::vec3& v0 = polygon[i];
+            const glm::vec3& v1 = polygon[(i + 1) % polygon.size()];
+            float d0 = glm::dot(normal, v0) - offset;
+            float d1 = glm::dot(normal, v1) - offset;
+            if (d0 <= 0.0f) scratch.push_back(v0);
+            if ((d0 < 0.0f && d1 > 0.0f) || (d0 > 0.0f && d1 < 0.0f)) {
+                scratch.push_back(v0 + (v1 - v0) * (d0 / (d0 - d1)));
+            }
+        }
+        polygon.swap(scratch);
+    }
+
+    // SAT on the 13 box-triangle axes, then clip the features the winning axis picks.
+    // Every axis can separate, but only convex edges may supply the contact normal.
+    void BoxTriangle(const LocalBox& box, const glm::vec3 (&v)[3], uint8_t convexEdges,
+                     std::vector<ContactPoint>& contacts) {
+        glm::vec3 e[3] = {v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+        glm::vec3 n = glm::cross(e[0], v[2] - v[0]);
+        float area = glm::length(n);
+        if (area < 1e-12f) return;
+        n /= area;
+
+        AxisResult best;
+        auto testAxis = [&](glm::vec3 axis, Feature feature, int boxIndex, int triIndex, bool canWin) {
+            float lengthSq = glm::length2(axis);
+            if (lengthSq < 1e-10f) return true;  // Parallel edges, no axis
+            axis /= std::sqrt(lengthSq);
+
+            float p0 = glm::dot(axis, v[0]), p1 = glm::dot(axis, v[1]), p2 = glm::dot(axis, v[2]);
+            float triMin = std::min(p0, std::min(p1, p2));
+            float triMax = std::max(p0, std::max(p1, p2));
+            float center = glm::dot(axis, box.center);
+            float radius = box.half.x * std::abs(glm::dot(box.axes[0], axis)) +
+                           box.half.y * std::abs(glm::dot(box.axes[1], axis)) +
+                           box.half.z * std::abs(glm::dot(box.axes[2], axis));
+
+            float up = triMax - (center - radius);    // Push the box along +axis
+            float down = (center + radius) - triMin;  // Push the box along -axis
+            float depth = std::min(up, down);
+            if (depth < -CONTACT_THRESHOLD) return false;
+
+            bool better = canWin && (best.feature == Feature::None ||
+                          (feature == best.feature ? depth < best.depth
+                                                   : depth < best.depth - FEATURE_TOLERANCE));
+            if (better) {
+                best.feature = feature;
+                best.depth = depth;
+                best.direction = up < down ? axis : -axis;
+                best.boxIndex = boxIndex;
+                best.triIndex = triIndex;
+            }
+            return true;
+        };
+
+        if (!testAxis(n, Feature::TriangleFace, -1, -1, true)) return;
+        for (int i = 0; i < 3; i++) {
+            if (!testAxis(box.axes[i], Feature::BoxFace, i, -1, convexEdges != 0)) return;
+        }
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                bool convex = (convexEdges >> j) & 1;
+                if (!testAxis(glm::cross(box.axes[i], e[j]), Feature::EdgeEdge, i, j, convex)) return;
+            }
+        }
+
+        glm::vec3 d = best.direction;
+        std::vector<glm::vec3> polygon, scratch;
+
+        if (best.feature == Feature::TriangleFace) {
+            // Box face most opposed to d, clipped to the triangle's side planes
+            int k = 0;
+            for (int i = 1; i < 3; i++) {
+                if (std::abs(glm::dot(box.axes[i], d)) > std::abs(glm::dot(box.axes[k], d))) k = i;
+            }
+            float side = glm::dot(box.axes[k], d) > 0.0f ? -1.0f : 1.0f;
+            int u = (k + 1) % 3, w = (k + 2) % 3;
+            glm::vec3 faceCenter = box.center + box.axes[k] * (side * box.half[k]);
+            glm::vec3 du = box.axes[u] * box.half[u], dw = box.axes[w] * box.half[w];
+            polygon = {faceCenter + du + dw, faceCenter - du + dw, faceCenter - du - dw, faceCenter + du - dw};
+
+            for (int j = 0; j < 3 && !polygon.empty(); j++) {
+                glm::vec3 sideNormal = glm::cross(e[j], n);
+                if (glm::dot(sideNormal, v[(j + 2) % 3] - v[j]) > 0.0f) sideNormal = -sideNormal;
+                ClipPolygon(polygon, scratch, sideNormal, glm::dot(sideNormal, v[j]));
+            }
+
+            float planeOffset = glm::dot(d, v[0]);
+            for (const glm::vec3& p : polygon) {
+                float separation = glm::dot(d, p) - planeOffset;
+                if (separation <= CONTACT_THRESHOLD) AddContact(contacts, p, d, -separation);
+            }
+        } else if (best.feature == Feature::BoxFace) {
+            // Triangle clipped to the box face facing it
+            int k = best.boxIndex;
+            glm::vec3 faceNormal = -d;
+            polygon = {v[0], v[1], v[2]};
+            for (int i = 0; i < 3 && !polygon.empty(); i++) {
+                if (i == k) continue;
+                float c = glm::dot(box.axes[i], box.center);
+                ClipPolygon(polygon, scratch, box.axes[i], c + box.half[i]);
+                if (!polygon.empty()) ClipPolygon(polygon, scratch, -box.axes[i], -c + box.half[i]);
+            }
+
+            float faceOffset = glm::dot(faceNormal, box.center) + box.half[k];
+            for (const glm::vec3& p : polygon) {
+                float separation = glm::dot(faceNormal, p) - faceOffset;
+                if (separation <= CONTACT_THRESHOLD) {
+                    AddContact(contacts, p - faceNormal * separation, d, -separation);
+                }
+            }
+        } else {
+            // Box edge nearest the triangle against the triangle edge
+            int i = best.boxIndex;
+            glm::vec3 edgeCenter = box.center;
+            for (int m = 0; m < 3; m++) {
+                if (m == i) continue;
+                edgeCenter += box.axes[m] * (box.half[m] * (glm::dot(box.axes[m], d) > 0.0f ? -1.0f : 1.0f));
+            }
+            glm::vec3 halfEdge = box.axes[i] * box.half[i];
+            glm::vec3 onBox, onTri;
+            int j = best.triIndex;
+            ClosestPoint::Segments(edgeCenter - halfEdge, edgeCenter + halfEdge, v[j], v[(j + 1) % 3], onBox, onTri);
+            AddContact(contacts, onBox, d, best.depth);
+        }
+    }
+
+    // Closest point lies in the interior of the face or on a convex edge/vertex
+    bool OnConvexFeature(const glm::vec3 (&v)[3], uint8_t convexEdges, const glm::vec3& closest) {
+        bool onEdge = false;
+        for (int j = 0; j < 3; j++) {
+            glm::vec3 edge = v[(j + 1) % 3] - v[j];
+            glm::vec3 offset = closest - v[j];
+            float along = glm::dot(offset, edge);
+            float lengthSq = glm::length2(edge);
+            if (glm::length2(offset * lengthSq - edge * along) > 1e-10f * lengthSq * lengthSq) continue;
+            onEdge = true;
+            if ((convexEdges >> j) & 1) return true;
+        }
+        return !onEdge;
+    }
+
+    void SphereTriangle(const glm::vec3& center, float radius, const glm::vec3 (&v)[3], uint8_t convexEdges,
+                        std::vector<ContactPoint>& contacts) {
+        float reach = radius + CONTACT_THRESHOLD;
+        glm::vec3 closest = ClosestPoint::OnTriangle(center, v[0], v[1], v[2]);
+        glm::vec3 delta = center - closest;
+        float distSq = glm::length2(delta);
+        if (distSq > reach * reach) return;
+
+        float dist = std::sqrt(distSq);
+        glm::vec3 faceNormal = glm::normalize(glm::cross(v[1] - v[0], v[2] - v[0]));
+        float height = glm::dot(center - v[0], faceNormal);
+        if (height < 0.0f) {
+            faceNormal = -faceNormal;
+            height = -height;
+        }
+
+        // Closest point on an internal edge or vertex: the neighbour covers that
+        // region, so fall back to this triangle's face normal
+        glm::vec3 normal;
+        if (dist < 1e-6f || !OnConvexFeature(v, convexEdges, closest)) {
+            normal = faceNormal;
+            dist = height;
+        } else {
+            normal = delta / dist;
+        }
+        AddContact(contacts, center - normal * radius, normal, radius - dist);
+    }
+
+    // GJK/EPA of a capsule or hull core against one triangle. Face contacts
+    // keep every core point over the triangle, so bodies lying flat get a
+    // patch rather than one point; internal edges take the face normal, as
+    // in SphereTriangle.
+    void CoreTriangle(const ConvexProxy& core, const glm::vec3& center, const glm::vec3 (&v)[3],
+                      uint8_t convexEdges, std::vector<ContactPoint>& contacts) {
+        ConvexProxy triangle(v, 3, glm::vec3(0.0f), glm::mat3(1.0f));
+        GJKResult result = GJK::Distance(triangle, core, nullptr);
+
+        glm::vec3 normal, onTriangle, onCore;
+        float penetration;
+        if (!result.overlap) {
+            float separation = result.distance - core.margin;
+            if (separation > CONTACT_THRESHOLD) return;
+            normal = (result.pointB - result.pointA) / result.distance;
+            onTriangle = result.pointA;
+            onCore = result.pointB;
+            penetration = -separation;
+        } else {
+            float depth;
+            if (!EPA::Penetration(triangle, core, result.simplex, normal, depth, onTriangle, onCore)) return;
+            penetration = depth + core.margin;
+        }
+
+        glm::vec3 faceNormal = glm::cross(v[1] - v[0], v[2] - v[0]);
+        float area = glm::length(faceNormal);
+        if (area < 1e-12f) return;
+        faceNormal /= area;
+        if (glm::dot(center - v[0], faceNormal) < 0.0f) faceNormal = -faceNormal;
+
+        if (std::abs(glm::dot(normal, faceNormal)) < FACE_ALIGNMENT && OnConvexFeature(v, convexEdges, onTriangle)) {
+            AddContact(contacts, onCore - normal * core.margin, normal, penetration);
+            return;
+        }
+
+        float offset = glm::dot(faceNormal, v[0]);
+        size_t before = contacts.size();
+        for (int i = 0; i < core.pointCount; i++) {
+            const glm::vec3& p = core.points[i];
+            float separation = glm::dot(faceNormal, p) - offset - core.margin;
+            if (separation > CONTACT_THRESHOLD) continue;
+            glm::vec3 onPlane = p - faceNormal * (separation + core.margin);
+            if (glm::length2(ClosestPoint::OnTriangle(onPlane, v[0], v[1], v[2]) - onPlane) > DUPLICATE_DISTANCE_SQ) continue;
+            AddContact(contacts, p - faceNormal * core.margin, faceNormal, -separation);
+        }
+        if (contacts.size() > before) return;
+
+        // No core point over this triangle: the deepest one against its plane
+        glm::vec3 deepest = core.SupportLocal(-faceNormal);
+        float separation = glm::dot(faceNormal, deepest) - offset - core.margin;
+        if (separation <= CONTACT_THRESHOLD) {
+            AddContact(contacts, deepest - faceNormal * core.margin, faceNormal, -separation);
+        }
+    }
+
+    LocalBox ToLocal(const RigidBody& terrain, const glm::mat3& rotTerrain,
+                     const RigidBody& box, const glm::mat3& rotBox) {
+        glm::mat3 invRot = glm::transpose(rotTerrain);
+        LocalBox local;
+        local.center = invRot * (box.position - terrain.position);
+        local.axes = invRot * rotBox;
+        local.half = box.AsBox().halfExtents;
+        return local;
+    }
+
+    // Triangulates only the cells under query, after the mips rule out the rest
+    template <class Fn>
+    void ForEachCellTriangle(const HeightfieldData& field, const AABB& query, Fn&& fn) {
+        int x0, z0, x1, z1;
+        if (!field.CellSpan(query, x0, z0, x1, z1)) return;
+        HeightRange span = field.RangeOver(x0, z0, x1, z1);
+        if (query.min.y > span.max || query.max.y < span.min) return;
+
+        glm::vec3 triangles[2][3];
+        uint8_t convexEdges[2];
+        for (int z = z0; z <= z1; z++) {
+            for (int x = x0; x <= x1; x++) {
+                const HeightRange& cell = field.CellRange(x, z);
+                if (query.min.y > cell.max || query.max.y < cell.min) continue;
+                field.CellTriangles(x, z, triangles, convexEdges);
+                fn(triangles[0], convexEdges[0]);
+                fn(triangles[1], convexEdges[1]);
+            }
+        }
+    }
+
+    ContactManifold ToWorld(const RigidBody& mesh, const glm::mat3& rotMesh, const RigidBody& body,
+                            std::vector<ContactPoint>& contacts) {
+        ContactManifold manifold;
+        manifold.a = (RigidBody*)&mesh;
+        manifold.b = (RigidBody*)&body;
+        if (contacts.empty()) return manifold;
+
+        int deepest = 0;
+        for (ContactPoint& cp : contacts) {
+            cp.point = mesh.position + rotMesh * cp.point;
+            cp.normal = rotMesh * cp.normal;
+        }
+        for (int i = 1; i < (int)contacts.size(); i++) {
+            if (contacts[i].penetration > contacts[deepest].penetration) deepest = i;
+        }
+
+        manifold.hasCollision = true;
+        manifold.normal = contacts[deepest].normal;
+        manifold.penetration = contacts[deepest].penetration;
+        ContactReduction::Reduce(contacts, manifold.normal);
+        manifold.contacts = std::move(contacts);
+        return manifold;
+    }
+
+    // World-space core points in; they are moved to terrain space and the
+    // proxy reads them in place
+    ContactManifold HeightfieldCore(const RigidBody& terrain, const glm::mat3& rotTerrain, const RigidBody& body,
+                                    std::vector<glm::vec3>& points, float margin) {
+        const HeightfieldData& field = *terrain.AsHeightfield().field;
+        glm::mat3 invRot = glm::transpose(rotTerrain);
+        glm::vec3 center = invRot * (body.position - terrain.position);
+
+        glm::vec3 lo = center, hi = center;
+        for (glm::vec3& p : points) {
+            p = invRot * (p - terrain.position);
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+        float reach = margin + CONTACT_THRESHOLD;
+        ConvexProxy core(points.data(), (int)points.size(), glm::vec3(0.0f), glm::mat3(1.0f));
+        core.margin = margin;
+
+        std::vector<ContactPoint> contacts;
+        ForEachCellTriangle(field, AABB(lo - glm::vec3(reach), hi + glm::vec3(reach)),
+                            [&](const glm::vec3 (&v)[3], uint8_t convexEdges) {
+            CoreTriangle(core, center, v, convexEdges, contacts);
+        });
+        return ToWorld(terrain, rotTerrain, body, contacts);
+    }
+}
+
+ContactManifold MeshCollision::DetectBox(const RigidBody& mesh, const glm::mat3& rotMesh,
+                                         const RigidBody& box, const glm::mat3& rotBox) {
+    const MeshData& data = *mesh.AsMesh().mesh;
+    LocalBox local = ToLocal(mesh, rotMesh, box, rotBox);
+
+    AABB query = box.AsBox().ComputeAABB(local.center, local.axes);
+    query.min -= glm::vec3(CONTACT_THRESHOLD);
+    query.max += glm::vec3(CONTACT_THRESHOLD);
+    candidates.clear();
+    data.QueryAABB(query, candidates);
+
+    std::vector<ContactPoint> contacts;
+    for (uint32_t t : candidates) {
+        glm::vec3 v[3];
+        data.GetTriangle(t, v[0], v[1], v[2]);
+        BoxTriangle(local, v, data.convexEdges[t], contacts);
+    }
+    return ToWorld(mesh, rotMesh, box, contacts);
+}
+
+ContactManifold MeshCollision::DetectSphere(const RigidBody& mesh, const glm::mat3& rotMesh,
+                                            const RigidBody& sphere) {
+    const MeshData& data = *mesh.AsMesh().mesh;
+    glm::vec3 center = glm::transpose(rotMesh) * (sphere.position - mesh.position);
+    float radius = sphere.AsSphere().radius;
+    float reach = radius + CONTACT_THRESHOLD;
+
+    candidates.clear();
+    data.QueryAABB(AABB(center - glm::vec3(reach), center + glm::vec3(reach)), candidates);
+
+    std::vector<ContactPoint> contacts;
+    for (uint32_t t : candidates) {
+        glm::vec3 v[3];
+        data.GetTriangle(t, v[0], v[1], v[2]);
+        SphereTriangle(center, radius, v, data.convexEdges[t], contacts);
+    }
+    return ToWorld(mesh, rotMesh, sphere, contacts);
+}
+
+ContactManifold MeshCollision::DetectHeightfieldBox(const RigidBody& terrain, const glm::mat3& rotTerrain,
+                                                    const RigidBody& box, const glm::mat3& rotBox) {
+    const HeightfieldData& field = *terrain.AsHeightfield().field;
+    LocalBox local = ToLocal(terrain, rotTerrain, box, rotBox);
+
+    AABB query = box.AsBox().ComputeAABB(local.center, local.axes);
+    query.min -= glm::vec3(CONTACT_THRESHOLD);
+    query.max += glm::vec3(CONTACT_THRESHOLD);
+
+    std::vector<ContactPoint> contacts;
+    ForEachCellTriangle(field, query, [&](const glm::vec3 (&v)[3], uint8_t convexEdges) {
+        BoxTriangle(local, v, convexEdges, contacts);
+    });
+    return ToWorld(terrain, rotTerrain, box, contacts);
+}
+
+ContactManifold MeshCollision::DetectHeightfieldSphere(const RigidBody& terrain, const glm::mat3& rotTerrain,
+                                                       const RigidBody& sphere) {
+    const HeightfieldData& field = *terrain.AsHeightfield().field;
+    glm::vec3 center = glm::transpose(rotTerrain) * (sphere.position - terrain.position);
+    float radius = sphere.AsSphere().radius;
+    float reach = radius + CONTACT_THRESHOLD;
+
+    std::vector<ContactPoint> contacts;
+    ForEachCellTriangle(field, AABB(center - glm::vec3(reach), center + glm::vec3(reach)),
+                        [&](const glm::vec3 (&v)[3], uint8_t convexEdges) {
+        SphereTriangle(center, radius, v, convexEdges, contacts);
+    });
+    return ToWorld(terrain, rotTerrain, sphere, contacts);
+}
+
+ContactManifold MeshCollision::DetectHeightfieldCapsule(const RigidBody& terrain, const glm::mat3& rotTerrain,
+                                                        const RigidBody& capsule, const glm::mat3& rotCapsule) {
+    const CapsuleShape& shape = capsule.AsCapsule();
+    glm::vec3 axis = rotCapsule[1] * shape.halfHeight;
+    std::vector<glm::vec3> points = {capsule.position - axis, capsule.position + axis};
+    return HeightfieldCore(terrain, rotTerrain, capsule, points, shape.radius);
+}
+
+ContactManifold MeshCollision::DetectHeightfieldHull(const RigidBody& terrain, const glm::mat3& rotTerrain,
+                                                     const RigidBody& hull, const glm::mat3& rotHull) {
+    const HullData& data = *hull.AsHull().hull;
+    std::vector<glm::vec3> points;
+    points.reserve(data.vertices.size());
+    for (const glm::vec3& v : data.vertices) points.push_back(hull.position + rotHull * v);
+    return HeightfieldCore(terrain, rotTerrain, hull, points, 0.0f);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/ContactManifold.h"
+
+// Box and sphere against static triangle geometry: meshes and heightfields.
+// Heightfields also take capsules and hulls, through GJK/EPA per triangle.
+// Only triangles in BVH leaves, or heightfield cells, touched by the body's
+// AABB are tested, so cost follows the body, not the terrain size.
+// manifold.a is the terrain; normals point out of it.
+class MeshCollision {
+public:
+    static ContactManifold DetectBox(const RigidBody& mesh, const glm::mat3& rotMesh,
+                                     const RigidBody& box, const glm::mat3& rotBox);
+    static ContactManifold DetectSphere(const RigidBody& mesh, const glm::mat3& rotMesh,
+                                        const RigidBody& sphere);
+
+    static ContactManifold DetectHeightfieldBox(const RigidBody& terrain, const glm::mat3& rotTerrain,
+                                                const RigidBody& box, const glm::mat3& rotBox);
+    static ContactManifold DetectHeightfieldSphere(const RigidBody& terrain, const glm::mat3& rotTerrain,
+                                                   const RigidBody& sphere);
+    static ContactManifold DetectHeightfieldCapsule(const RigidBody& terrain, const glm::mat3& rotTerrain,
+                                                    const RigidBody& capsule, const glm::mat3& rotCapsule);
+    static ContactManifold DetectHeightfieldHull(const RigidBody& terrain, const glm::mat3& rotTerrain,
+                                                 const RigidBody& hull, const glm::mat3& rotHull);
+};
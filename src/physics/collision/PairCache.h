@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// GJK simplex from the last query, stored as local support points on each
+// body so it can be re-expressed with the new poses
+struct SimplexCache {
+    int count = 0;
+    glm::vec3 localA[4];
+    glm::vec3 localB[4];
+};
+
+// What narrowphase learned about a pair last time it ran in full
+struct PairCacheEntry {
+    bool valid = false;
+    bool separated = false;          // axisIndex was a separating axis
+    bool flip = false;               // Normal points against the axis
+    int axisIndex = -1;              // SAT axis 0..14 (separating or least penetration)
+    glm::vec3 relPosition;           // B's position in A's frame
+    glm::quat relOrientation;        // B's orientation relative to A
+    SimplexCache simplex;            // Warm start for GJK kernels
+    uint64_t lastFrame = 0;
+};
+
+// Per-pair narrowphase cache keyed by stable body ids. Entries live densely
+// in one array with an open-addressed index over it, so a rollback snapshot
+// is two plain copies.
+class PairCache {
+public:
+    struct Pair {
+        uint64_t key;
+        PairCacheEntry entry;
+    };
+    struct Saved {
+        std::vector<Pair> pairs;
+        std::vector<uint32_t> index;
+        uint64_t frame = 0;
+    };
+
+    void BeginFrame() { ++frame; }
+
+    // Only inserts when the pair is new. Parallel narrowphase creates every
+    // pair's entry up front, so its workers only take the lookup path.
+    // References stay valid until the next insert or Prune.
+    PairCacheEntry& Get(uint32_t idA, uint32_t idB) {
+        uint64_t key = Key(idA, idB);
+        size_t bucket = index.empty() ? 0 : Find(key);
+        if (index.empty() || index[bucket] == EMPTY) {
+            if ((pairs.size() + 1) * 2 > index.size()) {
+                Grow();
+                bucket = Find(key);
+            }
+            index[bucket] = (uint32_t)pairs.size();
+            pairs.push_back({key, PairCacheEntry{}});
+        }
+        PairCacheEntry& entry = pairs[index[bucket]].entry;
+        entry.lastFrame = frame;
+        return entry;
+    }
+
+    // Drop pairs the broadphase didn't report this frame
+    void Prune() {
+        for (size_t i = 0; i < pairs.size();) {
+            if (pairs[i].entry.lastFrame == frame) {
+                ++i;
+                continue;
+            }
+            EraseBucket(Find(pairs[i].key));
+            // Fill the gap with the last pair; its bucket still finds it by key
+            if (i + 1 != pairs.size()) {
+                index[Find(pairs.back().key)] = (uint32_t)i;
+                pairs[i] = pairs.back();
+            }
+            pairs.pop_back();
+        }
+    }
+
+    // Copies reuse the destination's capacity, so a warm ring allocates nothing
+    void Save(Saved& out) const {
+        out.pairs = pairs;
+        out.index = index;
+        out.frame = frame;
+    }
+    void Restore(const Saved& saved) {
+        pairs = saved.pairs;
+        index = saved.index;
+        frame = saved.frame;
+    }
+
+    void Clear() {
+        pairs.clear();
+        std::fill(index.begin(), index.end(), EMPTY);
+    }
+    size_t Size() const { return pairs.size(); }
+
+private:
+    static constexpr uint32_t EMPTY = ~0u;
+    static constexpr size_t MIN_BUCKETS = 64;
+
+    static uint64_t Key(uint32_t idA, uint32_t idB) {
+        return (static_cast<uint64_t>(idA) << 32) | idB;
+    }
+    size_t Home(uint64_t key) const {
+        // Fibonacci hashing; ids are sequential, so spread them out
+        return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & (index.size() - 1);
+    }
+    // Bucket pointing at key's pair, or the empty bucket where it would go
+    size_t Find(uint64_t key) const {
+        size_t bucket = Home(key);
+        while (index[bucket] != EMPTY && pairs[index[bucket]].key != key) {
+            bucket = (bucket + 1) & (index.size() - 1);
+        }
+        return bucket;
+    }
+    void Grow() {
+        index.assign(std::max(index.size() * 2, MIN_BUCKETS), EMPTY);
+        for (uint32_t i = 0; i < (uint32_t)pairs.size(); i++) {
+            index[Find(pairs[i].key)] = i;
+        }
+    }
+    // Backward-shift delete: later buckets of the probe run move up so
+    // lookups never stop early at the hole
+    void EraseBucket(size_t hole) {
+        size_t mask = index.size() - 1;
+        for (size_t next = (hole + 1) & mask; index[next] != EMPTY; next = (next + 1) & mask) {
+            size_t home = Home(pairs[index[next]].key);
+            // Movable unless its home lies cyclically in (hole, next]
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                index[hole] = index[next];
+                hole = next;
+            }
+        }
+        index[hole] = EMPTY;
+    }
+
+    std::vector<Pair> pairs;
+    std::vector<uint32_t> index;  // Power-of-two size, at most half full
+    uint64_t frame = 0;
+};
@@ -0,0 +1,129 @@
+#include "PlaneCollision.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+    // Keep near-touching points as speculative contacts, same as SAT
+    constexpr float CONTACT_THRESHOLD = 0.05f;
+}
+
+ContactManifold PlaneCollision::DetectBox(const RigidBody& plane, const RigidBody& box, const glm::mat3& rotBox) {
+    ContactManifold manifold;
+    manifold.a = (RigidBody*)&plane;
+    manifold.b = (RigidBody*)&box;
+
+    const PlaneShape& shape = plane.AsPlane();
+    glm::vec3 half = box.AsBox().halfExtents;
+
+    // Early out on the box's support distance along the normal
+    float centerDistance = shape.SignedDistance(box.position);
+    float radius = half.x * std::abs(glm::dot(rotBox[0], shape.normal)) +
+                   half.y * std::abs(glm::dot(rotBox[1], shape.normal)) +
+                   half.z * std::abs(glm::dot(rotBox[2], shape.normal));
+    if (centerDistance - radius > CONTACT_THRESHOLD) return manifold;
+
+    for (int x = -1; x <= 1; x += 2) {
+        for (int y = -1; y <= 1; y += 2) {
+            for (int z = -1; z <= 1; z += 2) {
+                glm::vec3 corner = box.position + rotBox * (glm::vec3(x, y, z) * half);
+                float distance = shape.SignedDistance(corner);
+                if (distance > CONTACT_THRESHOLD) continue;
+
+                ContactPoint cp;
+                cp.point = corner;
+                cp.normal = shape.normal;
+                cp.penetration = -distance;
+                manifold.contacts.push_back(cp);
+            }
+        }
+    }
+
+    manifold.hasCollision = !manifold.contacts.empty();
+    manifold.normal = shape.normal;
+    manifold.penetration = radius - centerDistance;
+    return manifold;
+}
+
+ContactManifold PlaneCollision::DetectSphere(const RigidBody& plane, const RigidBody& sphere) {
+    ContactManifold manifold;
+    manifold.a = (RigidBody*)&plane;
+    manifold.b = (RigidBody*)&sphere;
+
+    const PlaneShape& shape = plane.AsPlane();
+    float radius = sphere.AsSphere().radius;
+    float distance = shape.SignedDistance(sphere.position) - radius;
+    if (distance > CONTACT_THRESHOLD) return manifold;
+
+    ContactPoint cp;
+    cp.point = sphere.position - shape.normal * radius;
+    cp.normal = shape.normal;
+    cp.penetration = -distance;
+    manifold.contacts.push_back(cp);
+
+    manifold.hasCollision = true;
+    manifold.normal = shape.normal;
+    manifold.penetration = -distance;
+    return manifold;
+}
+
+ContactManifold PlaneCollision::DetectCapsule(const RigidBody& plane, const RigidBody& capsule, const glm::mat3& rotCapsule) {
+    ContactManifold manifold;
+    manifold.a = (RigidBody*)&plane;
+    manifold.b = (RigidBody*)&capsule;
+
+    const PlaneShape& shape = plane.AsPlane();
+    const CapsuleShape& c = capsule.AsCapsule();
+
+    // One contact per end cap, so a lying capsule rests on two points
+    float deepest = -FLT_MAX;
+    for (int end = -1; end <= 1; end += 2) {
+        glm::vec3 center = capsule.position + rotCapsule[1] * (c.halfHeight * end);
+        float distance = shape.SignedDistance(center) - c.radius;
+        if (distance > CONTACT_THRESHOLD) continue;
+
+        ContactPoint cp;
+        cp.point = center - shape.normal * c.radius;
+        cp.normal = shape.normal;
+        cp.penetration = -distance;
+        manifold.contacts.push_back(cp);
+        deepest = std::max(deepest, -distance);
+    }
+
+    manifold.hasCollision = !manifold.contacts.empty();
+    manifold.normal = shape.normal;
+    manifold.penetration = manifold.hasCollision ? deepest : 0.0f;
+    return manifold;
+}
+
+ContactManifold PlaneCollision::DetectHull(const RigidBody& plane, const RigidBody& hull, const glm::mat3& rotHull) {
+    ContactManifold manifold;
+    manifold.a = (RigidBody*)&plane;
+    manifold.b = (RigidBody*)&hull;
+
+    const PlaneShape& shape = plane.AsPlane();
+    const HullData& data = *hull.AsHull().hull;
+
+    // Early out on the deepest vertex, found by hill climbing
+    glm::vec3 localNormal = glm::transpose(rotHull) * shape.normal;
+    glm::vec3 deepest = hull.position + rotHull * data.Support(-localNormal);
+    float minDistance = shape.SignedDistance(deepest);
+    if (minDistance > CONTACT_THRESHOLD) return manifold;
+
+    for (const glm::vec3& v : data.vertices) {
+        glm::vec3 corner = hull.position + rotHull * v;
+        float distance = shape.SignedDistance(corner);
+        if (distance > CONTACT_THRESHOLD) continue;
+
+        ContactPoint cp;
+        cp.point = corner;
+        cp.normal = shape.normal;
+        cp.penetration = -distance;
+        manifold.contacts.push_back(cp);
+    }
+
+    manifold.hasCollision = !manifold.contacts.empty();
+    manifold.normal = shape.normal;
+    manifold.penetration = -minDistance;
+    return manifold;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/ContactManifold.h"
+
+// Analytic half-space contacts. Only needs the body's support along the plane
+// normal, so it's far cheaper than running SAT against a huge floor box.
+class PlaneCollision {
+public:
+    // manifold.a is the plane body, normal points out of the plane towards the body
+    static ContactManifold DetectBox(const RigidBody& plane, const RigidBody& box, const glm::mat3& rotBox);
+    static ContactManifold DetectSphere(const RigidBody& plane, const RigidBody& sphere);
+    static ContactManifold DetectHull(const RigidBody& plane, const RigidBody& hull, const glm::mat3& rotHull);
+    static ContactManifold DetectCapsule(const RigidBody& plane, const RigidBody& capsule, const glm::mat3& rotCapsule);
+};
@@ -9,53 +9,52 @@
 #include <string>
 
 namespace {
-    void ProjectBoxOntoAxis(const RigidBody& body, const glm::vec3& axis, float& min, float& max) {
-        if (!body.shape) {
-            std::cerr << "🚨 ERROR: ProjectBoxOntoAxis() — shape is null!\n";
+    void ProjectBoxOntoAxis(const RigidBody& body, const glm::mat3& rot, const glm::vec3& axis, float& min, float& max) {
+        if (body.GetShapeType() != ShapeType::Box) {
+            std::cerr << "🚨 ERROR: ProjectBoxOntoAxis() — shape is not a box!\n";
             min = max = 0.0f;
             return;
         }
 
-        glm::mat3 rot = glm::toMat3(body.orientation);
-        glm::vec3 center = body.position;
-        glm::vec3 halfExtents = body.shape->halfExtents;
-
-        std::vector<glm::vec3> corners = {
-            {+halfExtents.x, +halfExtents.y, +halfExtents.z},
-            {-halfExtents.x, +halfExtents.y, +halfExtents.z},
-            {-halfExtents.x, -halfExtents.y, +halfExtents.z},
-            {+halfExtents.x, -halfExtents.y, +halfExtents.z},
-            {+halfExtents.x, +halfExtents.y, -halfExtents.z},
-            {-halfExtents.x, +halfExtents.y, -halfExtents.z},
-            {-halfExtents.x, -halfExtents.y, -halfExtents.z},
-            {+halfExtents.x, -halfExtents.y, -halfExtents.z}
-        };
-
-        min = std::numeric_limits<float>::infinity();
-        max = -std::numeric_limits<float>::infinity();
-
-        for (const auto& corner : corners) {
-            glm::vec3 worldCorner = center + rot * corner;
-            float projection = glm::dot(worldCorner, axis);
-            min = std::min(min, projection);
-            max = std::max(max, projection);
-        }
+        // Same interval as projecting all 8 corners, without building them
+        glm::vec3 halfExtents = body.AsBox().halfExtents;
+        float center = glm::dot(body.position, axis);
+        float radius = halfExtents.x * std::abs(glm::dot(rot[0], axis)) +
+                       halfExtents.y * std::abs(glm::dot(rot[1], axis)) +
+                       halfExtents.z * std::abs(glm::dot(rot[2], axis));
+
+        min = center - radius;
+        max = center + radius;
     }
 
-    float GetOverlapOnAxis(const RigidBody& a, const RigidBody& b, const glm::vec3& axis) {
+    float GetOverlapOnAxis(const RigidBody& a, const glm::mat3& rotA, const RigidBody& b, const glm::mat3& rotB, const glm::vec3& axis) {
         if (glm::length2(axis) < 1e-6f) return -1.0f;
         glm::vec3 normAxis = glm::normalize(axis);
         float minA, maxA, minB, maxB;
-        ProjectBoxOntoAxis(a, normAxis, minA, maxA);
-        ProjectBoxOntoAxis(b, normAxis, minB, maxB);
+        ProjectBoxOntoAxis(a, rotA, normAxis, minA, maxA);
+        ProjectBoxOntoAxis(b, rotB, normAxis, minB, maxB);
         float overlap = std::min(maxA, maxB) - std::max(minA, minB);
         return (overlap > 0) ? overlap : -1.0f;
     }
 
-    std::vector<glm::vec3> GetBoxAxes(const glm::quat& orientation) {
-        glm::mat3 rot = glm::toMat3(orientation);
-        return { rot[0], rot[1], rot[2] };
+    // SAT axis by index: 0-2 face axes of A, 3-5 face axes of B, 6-14 edge cross products.
+    // Returns false for a degenerate (parallel edges) cross product.
+    bool GetAxis(int index, const glm::mat3& rotA, const glm::mat3& rotB, glm::vec3& axis) {
+        if (index < 3) {
+            axis = rotA[index];
+        } else if (index < 6) {
+            axis = rotB[index - 3];
+        } else {
+            glm::vec3 cross = glm::cross(rotA[(index - 6) / 3], rotB[(index - 6) % 3]);
+            if (glm::length2(cross) <= 1e-6f) return false;
+            axis = glm::normalize(cross);
+        }
+        return true;
     }
+
+    // Relative motion below these and the cached axis is trusted as-is
+    constexpr float CACHE_POSITION_TOLERANCE = 0.005f;
+    constexpr float CACHE_ROTATION_TOLERANCE = 1e-5f;  // 1 - |dot(q, qCached)|
 }
 
 ContactManifold SATCollision::DetectCollision(const RigidBody& a, const RigidBody& b) {
@@ -63,50 +62,115 @@ ContactManifold SATCollision::DetectCollision(const RigidBody& a, const RigidBod
     manifold.a = (RigidBody*)&a;
     manifold.b = (RigidBody*)&b;
 
+    glm::mat3 rotA = glm::toMat3(a.orientation);
+    glm::mat3 rotB = glm::toMat3(b.orientation);
+
     float minOverlap = std::numeric_limits<float>::infinity();
     glm::vec3 smallestAxis;
     bool shouldFlip = false;
+    int separatingAxis;
+    FindLeastPenetrationAxis(a, rotA, b, rotB, minOverlap, smallestAxis, shouldFlip, separatingAxis);
+
+    if (separatingAxis >= 0 || minOverlap <= 0.0f || glm::length2(smallestAxis) < 1e-5f) {
+        manifold.hasCollision = false;
+        return manifold;
+    }
+
+    GenerateContacts(a, b, rotB, shouldFlip ? -smallestAxis : smallestAxis, minOverlap, manifold);
+    return manifold;
+}
+
+ContactManifold SATCollision::DetectCollision(const RigidBody& a, const glm::mat3& rotA,
+                                              const RigidBody& b, const glm::mat3& rotB,
+                                              PairCacheEntry& cache) {
+    glm::quat invOrientationA = glm::conjugate(a.orientation);
+    glm::vec3 relPosition = invOrientationA * (b.position - a.position);
+    glm::quat relOrientation = invOrientationA * b.orientation;
 
-    auto aAxes = GetBoxAxes(a.orientation);
-    auto bAxes = GetBoxAxes(b.orientation);
+    ContactManifold manifold;
+    manifold.a = (RigidBody*)&a;
+    manifold.b = (RigidBody*)&b;
 
-    std::vector<glm::vec3> axes = aAxes;
-    axes.insert(axes.end(), bAxes.begin(), bAxes.end());
+    if (cache.valid && cache.axisIndex >= 0) {
+        glm::vec3 axis;
+        bool axisValid = GetAxis(cache.axisIndex, rotA, rotB, axis);
 
-    for (const glm::vec3& aAxis : aAxes) {
-        for (const glm::vec3& bAxis : bAxes) {
-            glm::vec3 cross = glm::cross(aAxis, bAxis);
-            if (glm::length2(cross) > 1e-6f)
-                axes.push_back(glm::normalize(cross));
+        // Last frame's separating axis still separates: done
+        if (cache.separated && axisValid && GetOverlapOnAxis(a, rotA, b, rotB, axis) < 0.0f) {
+            manifold.hasCollision = false;
+            return manifold;
+        }
+
+        // Pose barely changed: keep the axis, only re-project the contacts
+        bool stillPose = glm::length2(relPosition - cache.relPosition) < CACHE_POSITION_TOLERANCE * CACHE_POSITION_TOLERANCE &&
+                         1.0f - std::abs(glm::dot(relOrientation, cache.relOrientation)) < CACHE_ROTATION_TOLERANCE;
+        if (!cache.separated && axisValid && stillPose) {
+            float overlap = GetOverlapOnAxis(a, rotA, b, rotB, axis);
+            if (overlap > 0.0f) {
+                GenerateContacts(a, b, rotB, cache.flip ? -axis : axis, overlap, manifold);
+                return manifold;
+            }
         }
     }
 
+    float minOverlap = std::numeric_limits<float>::infinity();
+    glm::vec3 smallestAxis;
+    bool shouldFlip = false;
+    int separatingAxis;
+    int minAxis = FindLeastPenetrationAxis(a, rotA, b, rotB, minOverlap, smallestAxis, shouldFlip, separatingAxis);
+
+    cache.valid = true;
+    cache.relPosition = relPosition;
+    cache.relOrientation = relOrientation;
+    cache.separated = separatingAxis >= 0;
+    cache.axisIndex = cache.separated ? separatingAxis : minAxis;
+    cache.flip = shouldFlip;
+
+    if (cache.separated || minOverlap <= 0.0f || glm::length2(smallestAxis) < 1e-5f) {
+        manifold.hasCollision = false;
+        return manifold;
+    }
+
+    GenerateContacts(a, b, rotB, shouldFlip ? -smallestAxis : smallestAxis, minOverlap, manifold);
+    return manifold;
+}
+
+int SATCollision::FindLeastPenetrationAxis(const RigidBody& a, const glm::mat3& rotA,
+                                           const RigidBody& b, const glm::mat3& rotB,
+                                           float& minOverlap, glm::vec3& smallestAxis,
+                                           bool& shouldFlip, int& separatingAxis) {
+    int minAxis = -1;
+    separatingAxis = -1;
+
     // SAT test: find axis of least penetration
-    for (const glm::vec3& axis : axes) {
-        float overlap = GetOverlapOnAxis(a, b, axis);
+    for (int i = 0; i < 15; ++i) {
+        glm::vec3 axis;
+        if (!GetAxis(i, rotA, rotB, axis)) continue;
+
+        float overlap = GetOverlapOnAxis(a, rotA, b, rotB, axis);
         if (overlap < 0.0f) {
-            manifold.hasCollision = false;
-            return manifold;  // Separating axis found
+            separatingAxis = i;  // Separating axis found
+            return minAxis;
         }
         if (overlap < minOverlap) {
             minOverlap = overlap;
             smallestAxis = glm::normalize(axis);
             shouldFlip = glm::dot(b.position - a.position, axis) < 0.0f;
+            minAxis = i;
         }
     }
 
-    if (minOverlap <= 0.0f || glm::length2(smallestAxis) < 1e-5f) {
-        manifold.hasCollision = false;
-        return manifold;
-    }
+    return minAxis;
+}
 
-    glm::vec3 collisionNormal = shouldFlip ? -smallestAxis : smallestAxis;
-    manifold.penetration = minOverlap;
+void SATCollision::GenerateContacts(const RigidBody& a, const RigidBody& b, const glm::mat3& rotB,
+                                    const glm::vec3& collisionNormal, float penetration,
+                                    ContactManifold& manifold) {
+    manifold.penetration = penetration;
     manifold.normal = collisionNormal;
 
     // === Generate multiple contact points using corners of B ===
-    glm::mat3 rotB = glm::toMat3(b.orientation);
-    glm::vec3 halfB = b.shape->halfExtents;
+    glm::vec3 halfB = b.AsBox().halfExtents;
 
     std::vector<glm::vec3> corners;
     for (int x = -1; x <= 1; x += 2) {
@@ -122,7 +186,7 @@ ContactManifold SATCollision::DetectCollision(const RigidBody& a, const RigidBod
     float contactThreshold = 0.05f;
 
     // Surface point of A (top surface along normal)
-    glm::vec3 planePoint = a.position + collisionNormal * glm::dot(a.shape->halfExtents, collisionNormal);
+    glm::vec3 planePoint = a.position + collisionNormal * glm::dot(a.AsBox().halfExtents, collisionNormal);
 
     for (const auto& corner : corners) {
         float dist = glm::dot(corner - planePoint, collisionNormal);
@@ -150,8 +214,6 @@ ContactManifold SATCollision::DetectCollision(const RigidBody& a, const RigidBod
     std::cout << "   Penetration: " << manifold.penetration << std::endl;
     std::cout << "   Normal: " << glm::to_string(manifold.normal) << std::endl;
     std::cout << "   Contact count: " << manifold.contacts.size() << std::endl;
-
-    return manifold;
 }
 
 
@@ -191,7 +253,7 @@ void SATCollision::ComputeIncidentFace(const glm::vec3& normalWorld, const Rigid
     if (absNormal.y > absNormal.x) axis = 1;
     if (absNormal.z > absNormal[axis]) axis = 2;
 
-    glm::vec3 half = incBody.shape->halfExtents;
+    glm::vec3 half = incBody.AsBox().halfExtents;
     float sign = localNormal[axis] < 0 ? 1.0f : -1.0f;
 
     glm::vec3 faceCenter = glm::vec3(0.0f);
@@ -2,13 +2,26 @@
 
 #include "physics/bodies/RigidBody.h"
 #include "physics/collision/ContactManifold.h"
+#include "physics/collision/PairCache.h"
 
 class SATCollision {
 public:
     static ContactManifold DetectCollision(const RigidBody& a, const RigidBody& b);
+    // Same, but exits early or skips the axis search using what the pair cache remembers
+    // Rotations come from the step's TransformCache
+    static ContactManifold DetectCollision(const RigidBody& a, const glm::mat3& rotA,
+                                           const RigidBody& b, const glm::mat3& rotB,
+                                           PairCacheEntry& cache);
     void ProjectBoxOntoAxis(const RigidBody& body, const glm::vec3& axis, float& min, float& max);
 
 private:
+    // Returns the least-penetration axis index; separatingAxis >= 0 if the boxes are apart
+    static int FindLeastPenetrationAxis(const RigidBody& a, const glm::mat3& rotA,
+                                        const RigidBody& b, const glm::mat3& rotB,
+                                        float& minOverlap, glm::vec3& smallestAxis,
+                                        bool& shouldFlip, int& separatingAxis);
+    static void GenerateContacts(const RigidBody& a, const RigidBody& b, const glm::mat3& rotB,
+                                 const glm::vec3& normal, float penetration, ContactManifold& manifold);
     static int Clip(const glm::vec3& n, float c, glm::vec3* faceIn, glm::vec3* faceOut);
     static void ComputeIncidentFace(const glm::vec3& normal, const RigidBody& incBody, glm::vec3* incidentVerts);
 };
@@ -0,0 +1,624 @@
+#include "SceneQuery.h"
+#include "physics/collision/GJK.h"
+#include "physics/collision/EPA.h"
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+    constexpr int MAX_CAST_ITERATIONS = 32;
+    constexpr float CAST_TOLERANCE = 1e-4f;    // Gap at which a cast counts as touching
+    constexpr float APPROACH_EPSILON = 1e-6f;  // Closing speeds below this never arrive
+    constexpr int BATCH_TILE_RAYS = 256;       // Rays per job in RaycastBatch
+    constexpr float MIN_SEARCH_RADIUS = 0.25f; // First ring a distance query looks in
+
+    AABB LocalBounds(const AABB& worldBox, const glm::vec3& position, const glm::mat3& rot) {
+        glm::mat3 invRot = glm::transpose(rot);
+        glm::vec3 center = invRot * ((worldBox.min + worldBox.max) * 0.5f - position);
+        glm::vec3 half = (worldBox.max - worldBox.min) * 0.5f;
+        glm::vec3 localHalf = glm::abs(invRot[0]) * half.x + glm::abs(invRot[1]) * half.y + glm::abs(invRot[2]) * half.z;
+        return AABB(center - localHalf, center + localHalf);
+    }
+
+    AABB ShapeBounds(const Shape& shape, const glm::vec3& position, const glm::mat3& rot) {
+        return std::visit([&](const auto& s) { return s.ComputeAABB(position, rot); }, shape);
+    }
+
+    // Convex pieces of a bounded body that may touch worldBox, as GJK proxies
+    // with their world bounds. fn returns false to stop; so does this.
+    template <class Fn>
+    bool ForEachPiece(const QueryBody& body, const AABB& worldBox, Fn&& fn) {
+        const Shape& shape = body.shape;
+        bool go = true;
+
+        if (const TriangleMeshShape* mesh = std::get_if<TriangleMeshShape>(&shape)) {
+            // One list per nesting level: distance queries walk two meshes at once
+            thread_local std::vector<uint32_t> candidateLists[2];
+            thread_local int nesting = 0;
+            std::vector<uint32_t>& candidates = candidateLists[nesting++];
+            candidates.clear();
+            mesh->mesh->QueryAABB(LocalBounds(worldBox, body.position, body.rotation), candidates);
+            for (uint32_t t : candidates) {
+                glm::vec3 v[3];
+                mesh->mesh->GetTriangle(t, v[0], v[1], v[2]);
+                for (glm::vec3& p : v) p = body.position + body.rotation * p;
+                AABB bounds(glm::min(v[0], glm::min(v[1], v[2])), glm::max(v[0], glm::max(v[1], v[2])));
+                if (!bounds.Overlaps(worldBox)) continue;
+                if (!fn(ConvexProxy(v, 3, glm::vec3(0.0f), glm::mat3(1.0f)), bounds)) {
+                    go = false;
+                    break;
+                }
+            }
+            nesting--;
+            return go;
+        }
+
+        if (const HeightfieldShape* terrain = std::get_if<HeightfieldShape>(&shape)) {
+            const HeightfieldData& field = *terrain->field;
+            AABB local = LocalBounds(worldBox, body.position, body.rotation);
+            int x0, z0, x1, z1;
+            if (!field.CellSpan(local, x0, z0, x1, z1)) return true;
+            HeightRange range = field.RangeOver(x0, z0, x1, z1);
+            if (range.max < local.min.y || range.min > local.max.y) return true;
+
+            glm::vec3 triangles[2][3];
+            uint8_t convexEdges[2];
+            for (int z = z0; z <= z1; z++) {
+                for (int x = x0; x <= x1; x++) {
+                    const HeightRange& cell = field.CellRange(x, z);
+                    if (cell.max < local.min.y || cell.min > local.max.y) continue;
+                    field.CellTriangles(x, z, triangles, convexEdges);
+                    for (auto& v : triangles) {
+                        for (glm::vec3& p : v) p = body.position + body.rotation * p;
+                        AABB bounds(glm::min(v[0], glm::min(v[1], v[2])), glm::max(v[0], glm::max(v[1], v[2])));
+                        if (!bounds.Overlaps(worldBox)) continue;
+                        if (!fn(ConvexProxy(v, 3, glm::vec3(0.0f), glm::mat3(1.0f)), bounds)) return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        if (const VoxelWorldShape* voxels = std::get_if<VoxelWorldShape>(&shape)) {
+            voxels->world->ForEachBox(LocalBounds(worldBox, body.position, body.rotation), [&](const VoxelBox& box) {
+                if (!go) return;
+                Shape piece = BoxShape(box.halfExtents);
+                glm::vec3 center = body.position + body.rotation * box.center;
+                go = fn(ConvexProxy(piece, center, body.rotation), ShapeBounds(piece, center, body.rotation));
+            });
+            return go;
+        }
+
+        if (const CompoundShape* compound = std::get_if<CompoundShape>(&shape)) {
+            compound->compound->ForEachChild(LocalBounds(worldBox, body.position, body.rotation),
+                                             [&](uint32_t, const CompoundChild& child) {
+                if (!go) return;
+                Shape piece = std::visit([](const auto& s) { return Shape(s); }, child.shape);
+                glm::vec3 center = body.position + body.rotation * child.position;
+                glm::mat3 rot = body.rotation * glm::mat3_cast(child.orientation);
+                go = fn(ConvexProxy(piece, center, rot), ShapeBounds(piece, center, rot));
+            });
+            return go;
+        }
+
+        return fn(ConvexProxy(shape, body.position, body.rotation), body.bounds);
+    }
+
+    // Conservative advancement: step the caster along dir by the GJK gap over
+    // the closing speed, which can never pass the first touching point
+    bool CastPiece(const ConvexProxy& caster, const ConvexProxy& piece, const glm::vec3& dir,
+                   float maxT, float& outT, glm::vec3& outPoint, glm::vec3& outNormal) {
+        ConvexProxy moving = caster;
+        float margins = caster.margin + piece.margin;
+        glm::vec3 n = dir;
+        float t = 0.0f;
+        for (int i = 0; i < MAX_CAST_ITERATIONS; i++) {
+            moving.position = caster.position + dir * t;
+            GJKResult r = GJK::Distance(moving, piece, nullptr);
+            if (r.overlap || r.distance - margins <= CAST_TOLERANCE) {
+                if (r.overlap || r.distance < margins) {
+                    if (t == 0.0f) {
+                        // Started inside: report it where the caster is
+                        outT = 0.0f;
+                        outPoint = caster.position;
+                        outNormal = -dir;
+                        return true;
+                    }
+                } else {
+                    n = (r.pointB - r.pointA) / r.distance;
+                }
+                outT = t;
+                outPoint = r.overlap ? moving.position : r.pointB - n * piece.margin;
+                outNormal = -n;
+                return true;
+            }
+
+            n = (r.pointB - r.pointA) / r.distance;
+            float approach = glm::dot(dir, n);
+            if (approach <= APPROACH_EPSILON) return false;
+            t += (r.distance - margins) / approach;
+            if (t > maxT) return false;
+        }
+
+        // Still closing in after every iteration: grazing contact, close enough
+        outT = t;
+        outPoint = moving.position;
+        outNormal = -n;
+        return true;
+    }
+
+    bool CastPlane(const ConvexProxy& caster, const PlaneShape& plane, const glm::vec3& dir,
+                   float maxT, float& outT, glm::vec3& outPoint) {
+        glm::vec3 deepest = caster.ToWorld(caster.SupportLocal(caster.ToLocalDir(-plane.normal))) -
+                            plane.normal * caster.margin;
+        float separation = plane.SignedDistance(deepest);
+        if (separation <= 0.0f) {
+            outT = 0.0f;
+            outPoint = deepest - plane.normal * separation;
+            return true;
+        }
+
+        float approach = -glm::dot(plane.normal, dir);
+        if (approach <= APPROACH_EPSILON) return false;
+        float t = separation / approach;
+        if (t > maxT) return false;
+        outT = t;
+        outPoint = deepest + dir * t;
+        return true;
+    }
+
+    // Nearest hit on one body within maxT
+    bool CastBody(const ConvexProxy& caster, const AABB& casterBounds, const QueryBody& body,
+                  const glm::vec3& dir, float maxT, QueryHit& hit) {
+        if (const PlaneShape* plane = std::get_if<PlaneShape>(&body.shape)) {
+            if (!CastPlane(caster, *plane, dir, maxT, hit.distance, hit.point)) return false;
+            hit.bodyId = body.id;
+            hit.normal = plane->normal;
+            return true;
+        }
+
+        glm::vec3 motion = dir * maxT;
+        AABB swept(casterBounds.min + glm::min(motion, glm::vec3(0.0f)),
+                   casterBounds.max + glm::max(motion, glm::vec3(0.0f)));
+        glm::vec3 extent = (casterBounds.max - casterBounds.min) * 0.5f;
+        glm::vec3 center = (casterBounds.min + casterBounds.max) * 0.5f;
+        glm::vec3 invDir = 1.0f / dir;
+
+        bool found = false;
+        float best = maxT;
+        ForEachPiece(body, swept, [&](const ConvexProxy& piece, const AABB& bounds) {
+            if (!BroadphaseTree::SegmentHits(bounds, extent, center, invDir, best)) return true;
+            float t;
+            glm::vec3 point, normal;
+            if (CastPiece(caster, piece, dir, best, t, point, normal) && (!found || t < best)) {
+                found = true;
+                best = t;
+                hit.point = point;
+                hit.normal = normal;
+            }
+            return best > 0.0f;  // Nothing beats a hit at the start
+        });
+        if (!found) return false;
+        hit.bodyId = body.id;
+        hit.distance = best;
+        return true;
+    }
+
+    // Rays get closed-form tests for boxes, spheres and planes; everything
+    // else is cast as a single point
+    bool RaycastBody(const glm::vec3& origin, const glm::vec3& dir, const QueryBody& body,
+                     float maxT, QueryHit& hit) {
+        hit.bodyId = body.id;
+        if (const BoxShape* box = std::get_if<BoxShape>(&body.shape)) {
+            glm::mat3 invRot = glm::transpose(body.rotation);
+            glm::vec3 localOrigin = invRot * (origin - body.position);
+            glm::vec3 localDir = invRot * dir;
+            float tMin = 0.0f;
+            float tMax = maxT;
+            int enterAxis = -1;
+            for (int axis = 0; axis < 3; axis++) {
+                float h = box->halfExtents[axis];
+                if (std::abs(localDir[axis]) < 1e-12f) {
+                    if (localOrigin[axis] < -h || localOrigin[axis] > h) return false;
+                    continue;
+                }
+                float inv = 1.0f / localDir[axis];
+                float t0 = (-h - localOrigin[axis]) * inv;
+                float t1 = (h - localOrigin[axis]) * inv;
+                if (t0 > t1) std::swap(t0, t1);
+                if (t0 > tMin) {
+                    tMin = t0;
+                    enterAxis = axis;
+                }
+                tMax = std::min(tMax, t1);
+                if (tMin > tMax) return false;
+            }
+            hit.distance = tMin;
+            hit.point = origin + dir * tMin;
+            if (enterAxis < 0) {
+                hit.normal = -dir;  // Started inside
+            } else {
+                hit.normal = body.rotation[enterAxis] * (localDir[enterAxis] > 0.0f ? -1.0f : 1.0f);
+            }
+            return true;
+        }
+
+        if (const SphereShape* sphere = std::get_if<SphereShape>(&body.shape)) {
+            glm::vec3 m = origin - body.position;
+            float b = glm::dot(m, dir);
+            float c = glm::dot(m, m) - sphere->radius * sphere->radius;
+            if (c <= 0.0f) {
+                hit.distance = 0.0f;
+                hit.point = origin;
+                hit.normal = -dir;
+                return true;
+            }
+            float discriminant = b * b - c;
+            if (b > 0.0f || discriminant < 0.0f) return false;
+            float t = -b - std::sqrt(discriminant);
+            if (t > maxT) return false;
+            hit.distance = t;
+            hit.point = origin + dir * t;
+            hit.normal = (hit.point - body.position) / sphere->radius;
+            return true;
+        }
+
+        const glm::vec3 rayPoint(0.0f);
+        ConvexProxy caster(&rayPoint, 1, origin, glm::mat3(1.0f));
+        return CastBody(caster, AABB(origin, origin), body, dir, maxT, hit);
+    }
+
+    AABB Grow(const AABB& box, float amount) {
+        return AABB(box.min - glm::vec3(amount), box.max + glm::vec3(amount));
+    }
+
+    // Gap between two boxes, 0 if they overlap
+    float BoundsGap(const AABB& a, const AABB& b) {
+        glm::vec3 gap = glm::max(glm::max(a.min - b.max, b.min - a.max), glm::vec3(0.0f));
+        return glm::length(gap);
+    }
+
+    void PieceDistance(const ConvexProxy& a, const ConvexProxy& b, DistanceResult& result) {
+        GJKResult r = GJK::Distance(a, b, nullptr);
+        float margins = a.margin + b.margin;
+        if (!r.overlap && r.distance > margins) {
+            glm::vec3 n = (r.pointB - r.pointA) / r.distance;
+            result.pointA = r.pointA + n * a.margin;
+            result.pointB = r.pointB - n * b.margin;
+            result.distance = r.distance - margins;
+            return;
+        }
+
+        result.distance = 0.0f;
+        glm::vec3 normal;
+        float depth;
+        if (r.overlap && EPA::Penetration(a, b, r.simplex, normal, depth, result.pointA, result.pointB)) {
+            result.pointA += normal * a.margin;
+            result.pointB -= normal * b.margin;
+        } else if (!r.overlap) {
+            // Only the margins overlap: meet halfway between the cores
+            result.pointA = result.pointB = (r.pointA + r.pointB) * 0.5f;
+        } else {
+            result.pointA = result.pointB = (a.position + b.position) * 0.5f;
+        }
+    }
+
+    void PlaneDistance(const ConvexProxy& a, const PlaneShape& plane, DistanceResult& result) {
+        result.pointA = a.ToWorld(a.SupportLocal(a.ToLocalDir(-plane.normal))) - plane.normal * a.margin;
+        float separation = plane.SignedDistance(result.pointA);
+        result.pointB = result.pointA - plane.normal * separation;
+        result.distance = std::max(separation, 0.0f);
+    }
+
+    // Closest pair between A's pieces and B's. forEachA(box, fn) enumerates
+    // A's pieces near box, like ForEachPiece. The search ring doubles until
+    // the best pair found is inside it, so nearby pieces are all that gets
+    // visited; maxRadius caps it for within-radius queries.
+    template <class PiecesA>
+    bool ClosestPieces(PiecesA&& forEachA, const AABB& boundsA, const QueryBody& b,
+                       float maxRadius, DistanceResult& result) {
+        result.bodyId = b.id;
+        result.distance = FLT_MAX;
+        if (const PlaneShape* plane = std::get_if<PlaneShape>(&b.shape)) {
+            forEachA(boundsA, [&](const ConvexProxy& pieceA, const AABB&) {
+                DistanceResult candidate;
+                PlaneDistance(pieceA, *plane, candidate);
+                if (candidate.distance < result.distance) {
+                    result.pointA = candidate.pointA;
+                    result.pointB = candidate.pointB;
+                    result.distance = candidate.distance;
+                }
+                return result.distance > 0.0f;
+            });
+            return result.distance <= maxRadius;
+        }
+
+        float gap = BoundsGap(boundsA, b.bounds);
+        if (gap > maxRadius) return false;
+        glm::vec3 span = glm::max(boundsA.max, b.bounds.max) - glm::min(boundsA.min, b.bounds.min);
+        float everything = glm::length(span);
+        float radius = std::min(std::max(gap * 2.0f, MIN_SEARCH_RADIUS), maxRadius);
+        for (;;) {
+            forEachA(Grow(b.bounds, radius), [&](const ConvexProxy& pieceA, const AABB& piecesBounds) {
+                return ForEachPiece(b, Grow(piecesBounds, std::min(radius, result.distance)),
+                                    [&](const ConvexProxy& pieceB, const AABB&) {
+                    DistanceResult candidate;
+                    PieceDistance(pieceA, pieceB, candidate);
+                    if (candidate.distance < result.distance) {
+                        result.pointA = candidate.pointA;
+                        result.pointB = candidate.pointB;
+                        result.distance = candidate.distance;
+                    }
+                    return result.distance > 0.0f;
+                });
+            });
+            if (result.distance <= radius || radius >= maxRadius || radius >= everything) break;
+            radius = std::min(radius * 2.0f, maxRadius);
+        }
+        return result.distance <= maxRadius;
+    }
+
+    bool Overlaps(const ConvexProxy& query, const QueryBody& body, const AABB& queryBounds) {
+        if (const PlaneShape* plane = std::get_if<PlaneShape>(&body.shape)) {
+            glm::vec3 deepest = query.ToWorld(query.SupportLocal(query.ToLocalDir(-plane->normal)));
+            return plane->SignedDistance(deepest) <= query.margin;
+        }
+
+        bool hit = false;
+        ForEachPiece(body, queryBounds, [&](const ConvexProxy& piece, const AABB&) {
+            GJKResult r = GJK::Distance(query, piece, nullptr);
+            hit = r.overlap || r.distance <= query.margin + piece.margin;
+            return !hit;
+        });
+        return hit;
+    }
+
+    QueryBody MakeQueryBody(const RigidBody& body, const VoxelSnapshots& voxelSnapshots) {
+        glm::mat3 rot = glm::mat3_cast(body.orientation);
+        QueryBody query{body.id, body.layers, body.position, rot, body.shape, body.ComputeAABB(rot)};
+        if (std::holds_alternative<VoxelWorldShape>(body.shape)) {
+            auto it = voxelSnapshots.find(body.id);
+            if (it != voxelSnapshots.end()) query.shape = VoxelWorldShape(it->second);
+        }
+        return query;
+    }
+}
+
+std::shared_ptr<const SceneQuery> SceneQuery::Build(const std::vector<RigidBody>& bodies,
+                                                    const std::vector<RigidBody>& planes,
+                                                    const VoxelSnapshots& voxelSnapshots) {
+    auto query = std::make_shared<SceneQuery>();
+    query->bodies.reserve(bodies.size());
+    for (const RigidBody& body : bodies) {
+        if (body.GetShapeType() == ShapeType::Plane) query->planes.push_back(MakeQueryBody(body, voxelSnapshots));
+        else query->bodies.push_back(MakeQueryBody(body, voxelSnapshots));
+    }
+    for (const RigidBody& plane : planes) {
+        query->planes.push_back(MakeQueryBody(plane, voxelSnapshots));
+    }
+
+    for (const QueryBody& body : query->bodies) query->byId[body.id] = &body;
+    for (const QueryBody& plane : query->planes) query->byId[plane.id] = &plane;
+
+    std::vector<AABB> aabbs(query->bodies.size());
+    for (size_t i = 0; i < aabbs.size(); i++) aabbs[i] = query->bodies[i].bounds;
+    query->tree.Build(aabbs);
+    return query;
+}
+
+bool SceneQuery::Cast(const Shape* casterShape, const glm::vec3& origin, const glm::mat3& rot,
+                      const glm::vec3& dir, float maxDistance, uint32_t layerMask, CastMode mode,
+                      QueryHit* closest, const HitCallback* fn) const {
+    // A ray is a cast of a single point
+    const glm::vec3 rayPoint(0.0f);
+    ConvexProxy caster = casterShape ? ConvexProxy(*casterShape, origin, rot) : ConvexProxy(&rayPoint, 1, origin, rot);
+    AABB casterBounds = casterShape ? ShapeBounds(*casterShape, origin, rot) : AABB(origin, origin);
+
+    auto castBody = [&](const QueryBody& body, float maxT, QueryHit& hit) {
+        if (!casterShape) return RaycastBody(origin, dir, body, maxT, hit);
+        return CastBody(caster, casterBounds, body, dir, maxT, hit);
+    };
+
+    bool found = false;
+    float maxT = maxDistance;
+    // Returns false once the query is done
+    auto report = [&](const QueryHit& hit) {
+        found = true;
+        if (mode == CastMode::Any) return false;
+        if (mode == CastMode::All) return (*fn)(hit);
+        *closest = hit;
+        maxT = hit.distance;
+        return true;
+    };
+
+    for (const QueryBody& plane : planes) {
+        if (!(plane.layers & layerMask)) continue;
+        QueryHit hit;
+        if (castBody(plane, maxT, hit) && !report(hit)) return found;
+    }
+
+    glm::vec3 extent = (casterBounds.max - casterBounds.min) * 0.5f;
+    glm::vec3 center = (casterBounds.min + casterBounds.max) * 0.5f;
+    tree.Raycast(center, dir, maxT, extent, [&](int index, float& treeMaxT) {
+        const QueryBody& body = bodies[index];
+        if (!(body.layers & layerMask)) return true;
+        QueryHit hit;
+        if (!castBody(body, maxT, hit)) return true;
+        bool go = report(hit);
+        treeMaxT = maxT;
+        return go;
+    });
+    return found;
+}
+
+bool SceneQuery::RaycastClosest(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+                                QueryHit& hit, uint32_t layerMask) const {
+    return Cast(nullptr, origin, glm::mat3(1.0f), dir, maxDistance, layerMask, CastMode::Closest, &hit, nullptr);
+}
+
+bool SceneQuery::RaycastAny(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+                            uint32_t layerMask) const {
+    return Cast(nullptr, origin, glm::mat3(1.0f), dir, maxDistance, layerMask, CastMode::Any, nullptr, nullptr);
+}
+
+void SceneQuery::RaycastAll(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+                            const HitCallback& fn, uint32_t layerMask) const {
+    Cast(nullptr, origin, glm::mat3(1.0f), dir, maxDistance, layerMask, CastMode::All, nullptr, &fn);
+}
+
+void SceneQuery::RaycastBatch(const RaycastBatchInput& input, const RaycastBatchOutput& output) const {
+    int tiles = (input.count + BATCH_TILE_RAYS - 1) / BATCH_TILE_RAYS;
+    JobSystem::ParallelFor(tiles, 1, [&](int first, int last) {
+        for (int tile = first; tile < last; tile++) {
+            int begin = tile * BATCH_TILE_RAYS;
+            RaycastTile(input, output, begin, std::min(begin + BATCH_TILE_RAYS, input.count));
+        }
+    });
+}
+
+void SceneQuery::RaycastTile(const RaycastBatchInput& input, const RaycastBatchOutput& output,
+                             int begin, int end) const {
+    constexpr int W = RayPacket::WIDTH;
+    for (int first = begin; first < end; first += W) {
+        int lanes = std::min(W, end - first);
+        RayPacket packet;
+        QueryHit best[W];
+        for (int lane = 0; lane < W; lane++) {
+            best[lane].bodyId = NO_HIT;
+            best[lane].distance = input.maxDistance;
+            best[lane].normal = glm::vec3(0.0f);
+            if (lane < lanes) packet.SetRay(lane, input.origins[first + lane], input.directions[first + lane], input.maxDistance);
+            else packet.Clear(lane);
+        }
+
+        auto test = [&](const QueryBody& body, int lane) {
+            QueryHit hit;
+            const glm::vec3& origin = input.origins[first + lane];
+            const glm::vec3& dir = input.directions[first + lane];
+            if (!RaycastBody(origin, dir, body, packet.maxT[lane], hit)) return;
+            best[lane] = hit;
+            packet.maxT[lane] = hit.distance;
+        };
+
+        for (const QueryBody& plane : planes) {
+            if (!(plane.layers & input.layerMask)) continue;
+            for (int lane = 0; lane < lanes; lane++) test(plane, lane);
+        }
+
+        tree.RaycastPacket(packet, [&](int index, uint32_t laneMask) {
+            const QueryBody& body = bodies[index];
+            if (!(body.layers & input.layerMask)) return true;
+            for (int lane = 0; lane < lanes; lane++) {
+                if (laneMask & (1u << lane)) test(body, lane);
+            }
+            return true;
+        });
+
+        for (int lane = 0; lane < lanes; lane++) {
+            int i = first + lane;
+            output.bodyId[i] = best[lane].bodyId;
+            output.distance[i] = best[lane].distance;
+            output.normalX[i] = best[lane].normal.x;
+            output.normalY[i] = best[lane].normal.y;
+            output.normalZ[i] = best[lane].normal.z;
+        }
+    }
+}
+
+bool SceneQuery::SweepSphere(const glm::vec3& center, float radius, const glm::vec3& dir, float maxDistance,
+                             QueryHit& hit, uint32_t layerMask) const {
+    Shape sphere = SphereShape(radius);
+    return Cast(&sphere, center, glm::mat3(1.0f), dir, maxDistance, layerMask, CastMode::Closest, &hit, nullptr);
+}
+
+bool SceneQuery::SweepBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::mat3& rot,
+                          const glm::vec3& dir, float maxDistance, QueryHit& hit, uint32_t layerMask) const {
+    Shape box = BoxShape(halfExtents);
+    return Cast(&box, center, rot, dir, maxDistance, layerMask, CastMode::Closest, &hit, nullptr);
+}
+
+void SceneQuery::Overlap(const Shape& shape, const glm::vec3& center, const glm::mat3& rot,
+                         const BodyCallback& fn, uint32_t layerMask) const {
+    ConvexProxy query(shape, center, rot);
+    AABB bounds = ShapeBounds(shape, center, rot);
+
+    for (const QueryBody& plane : planes) {
+        if ((plane.layers & layerMask) && Overlaps(query, plane, bounds) && !fn(plane.id)) return;
+    }
+    tree.Query(bounds, [&](int index) {
+        const QueryBody& body = bodies[index];
+        if (!(body.layers & layerMask) || !Overlaps(query, body, bounds)) return true;
+        return fn(body.id);
+    });
+}
+
+void SceneQuery::OverlapAABB(const AABB& box, const BodyCallback& fn, uint32_t layerMask) const {
+    Shape shape = BoxShape((box.max - box.min) * 0.5f);
+    Overlap(shape, (box.min + box.max) * 0.5f, glm::mat3(1.0f), fn, layerMask);
+}
+
+void SceneQuery::OverlapOBB(const glm::vec3& center, const glm::vec3& halfExtents, const glm::mat3& rot,
+                            const BodyCallback& fn, uint32_t layerMask) const {
+    Shape shape = BoxShape(halfExtents);
+    Overlap(shape, center, rot, fn, layerMask);
+}
+
+const QueryBody* SceneQuery::FindBody(uint32_t id) const {
+    auto it = byId.find(id);
+    return it == byId.end() ? nullptr : it->second;
+}
+
+bool SceneQuery::ClosestPoint(const glm::vec3& point, uint32_t bodyId, DistanceResult& result) const {
+    const QueryBody* body = FindBody(bodyId);
+    if (!body) return false;
+    const glm::vec3 origin(0.0f);
+    ConvexProxy proxy(&origin, 1, point, glm::mat3(1.0f));
+    AABB bounds(point, point);
+    auto pointPieces = [&](const AABB&, auto&& fn) { return fn(proxy, bounds); };
+    return ClosestPieces(pointPieces, bounds, *body, FLT_MAX, result);
+}
+
+bool SceneQuery::Distance(uint32_t bodyIdA, uint32_t bodyIdB, DistanceResult& result) const {
+    const QueryBody* a = FindBody(bodyIdA);
+    const QueryBody* b = FindBody(bodyIdB);
+    if (!a || !b) return false;
+
+    // Planes have no bounds to search from, so put them on the B side
+    bool swapped = std::holds_alternative<PlaneShape>(a->shape);
+    if (swapped) std::swap(a, b);
+    if (std::holds_alternative<PlaneShape>(a->shape)) return false;
+
+    auto bodyPieces = [&](const AABB& box, auto&& fn) { return ForEachPiece(*a, box, fn); };
+    if (!ClosestPieces(bodyPieces, a->bounds, *b, FLT_MAX, result)) return false;
+    if (swapped) std::swap(result.pointA, result.pointB);
+    result.bodyId = bodyIdB;
+    return true;
+}
+
+void SceneQuery::BodiesWithinRadius(const glm::vec3& point, float radius, std::vector<DistanceResult>& out,
+                                    uint32_t layerMask) const {
+    out.clear();
+    const glm::vec3 origin(0.0f);
+    ConvexProxy proxy(&origin, 1, point, glm::mat3(1.0f));
+    AABB bounds(point, point);
+    auto pointPieces = [&](const AABB&, auto&& fn) { return fn(proxy, bounds); };
+
+    DistanceResult result;
+    for (const QueryBody& plane : planes) {
+        if ((plane.layers & layerMask) && ClosestPieces(pointPieces, bounds, plane, radius, result)) {
+            out.push_back(result);
+        }
+    }
+    tree.Query(Grow(bounds, radius), [&](int index) {
+        const QueryBody& body = bodies[index];
+        if ((body.layers & layerMask) && ClosestPieces(pointPieces, bounds, body, radius, result)) {
+            out.push_back(result);
+        }
+        return true;
+    });
+
+    std::sort(out.begin(), out.end(), [](const DistanceResult& l, const DistanceResult& r) {
+        return l.distance < r.distance;
+    });
+}
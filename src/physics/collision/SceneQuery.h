@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/Broadphase.h"
+
+struct QueryHit {
+    uint32_t bodyId;
+    glm::vec3 point;   // On the hit body's surface
+    glm::vec3 normal;  // Surface normal there, facing back along the cast
+    float distance;    // Along the cast direction; 0 if it started overlapping
+};
+
+struct DistanceResult {
+    uint32_t bodyId;
+    glm::vec3 pointA;  // On the query point or first body
+    glm::vec3 pointB;  // On bodyId
+    // 0 when overlapping; the points are then the deepest ones EPA finds
+    float distance;
+};
+
+// Rays for RaycastBatch. Consecutive rays share a packet, so keep coherent
+// rays (one sensor's scan line) next to each other.
+struct RaycastBatchInput {
+    const glm::vec3* origins;
+    const glm::vec3* directions;  // Normalized
+    int count;
+    float maxDistance;
+    uint32_t layerMask = 0xFFFFFFFFu;
+};
+
+// Caller-owned SoA output, count entries per array. A miss leaves
+// bodyId = SceneQuery::NO_HIT and distance = maxDistance.
+struct RaycastBatchOutput {
+    uint32_t* bodyId;
+    float* distance;
+    float* normalX;
+    float* normalY;
+    float* normalZ;
+};
+
+// Frozen copy of each voxel world body, by id, taken after its last edit
+using VoxelSnapshots = std::unordered_map<uint32_t, std::shared_ptr<VoxelWorld>>;
+
+// What a query needs from one body, copied out at the end of a step
+struct QueryBody {
+    uint32_t id;
+    uint32_t layers;
+    glm::vec3 position;
+    glm::mat3 rotation;
+    Shape shape;
+    AABB bounds;
+};
+
+// Read-only picture of the world after one completed step. Every method is
+// const and touches no shared mutable state, so any number of threads can
+// query the same snapshot while the scene steps on. Shape data is shared,
+// not copied; voxel worlds are swapped for their frozen copies, since the
+// live ones are edited between steps.
+class SceneQuery {
+public:
+    static constexpr uint32_t ALL_LAYERS = 0xFFFFFFFFu;
+    static constexpr uint32_t NO_HIT = 0xFFFFFFFFu;
+
+    // Return false from a callback to end the query early
+    using HitCallback = std::function<bool(const QueryHit&)>;
+    using BodyCallback = std::function<bool(uint32_t bodyId)>;
+
+    static std::shared_ptr<const SceneQuery> Build(const std::vector<RigidBody>& bodies,
+                                                   const std::vector<RigidBody>& planes,
+                                                   const VoxelSnapshots& voxelSnapshots = {});
+
+    // dir must be normalized; distances are along it
+    bool RaycastClosest(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+                        QueryHit& hit, uint32_t layerMask = ALL_LAYERS) const;
+    bool RaycastAny(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+                    uint32_t layerMask = ALL_LAYERS) const;
+    // Every body the ray hits, nearest hit per body, in no particular order
+    void RaycastAll(const glm::vec3& origin, const glm::vec3& dir, float maxDistance,
+                    const HitCallback& fn, uint32_t layerMask = ALL_LAYERS) const;
+
+    // Closest hit for every ray, in packets of RayPacket::WIDTH, spread over
+    // the job system by tiles. Allocates nothing once warmed up.
+    void RaycastBatch(const RaycastBatchInput& input, const RaycastBatchOutput& output) const;
+
+    // Closest points between a point or a body and another body, by id
+    bool ClosestPoint(const glm::vec3& point, uint32_t bodyId, DistanceResult& result) const;
+    bool Distance(uint32_t bodyIdA, uint32_t bodyIdB, DistanceResult& result) const;
+    // Every body within radius of point, nearest first. Reuses out's storage,
+    // so polling every frame with the same vector doesn't allocate.
+    void BodiesWithinRadius(const glm::vec3& point, float radius, std::vector<DistanceResult>& out,
+                            uint32_t layerMask = ALL_LAYERS) const;
+
+    const QueryBody* FindBody(uint32_t id) const;
+
+    // Bodies whose shape (not just bounds) overlaps the box
+    void OverlapAABB(const AABB& box, const BodyCallback& fn, uint32_t layerMask = ALL_LAYERS) const;
+    void OverlapOBB(const glm::vec3& center, const glm::vec3& halfExtents, const glm::mat3& rot,
+                    const BodyCallback& fn, uint32_t layerMask = ALL_LAYERS) const;
+
+    // First body a shape moving along dir would touch
+    bool SweepSphere(const glm::vec3& center, float radius, const glm::vec3& dir, float maxDistance,
+                     QueryHit& hit, uint32_t layerMask = ALL_LAYERS) const;
+    bool SweepBox(const glm::vec3& center, const glm::vec3& halfExtents, const glm::mat3& rot,
+                  const glm::vec3& dir, float maxDistance, QueryHit& hit,
+                  uint32_t layerMask = ALL_LAYERS) const;
+
+    const std::vector<QueryBody>& Bodies() const { return bodies; }
+
+private:
+    std::vector<QueryBody> bodies;
+    std::vector<QueryBody> planes;  // Unbounded, so kept out of the tree
+    BroadphaseTree tree;
+    std::unordered_map<uint32_t, const QueryBody*> byId;
+
+    enum class CastMode { Closest, Any, All };
+
+    // Shared by raycasts and sweeps: the caster shape translates along dir
+    bool Cast(const Shape* casterShape, const glm::vec3& origin, const glm::mat3& rot,
+              const glm::vec3& dir, float maxDistance, uint32_t layerMask, CastMode mode,
+              QueryHit* closest, const HitCallback* fn) const;
+    void RaycastTile(const RaycastBatchInput& input, const RaycastBatchOutput& output, int begin, int end) const;
+    void Overlap(const Shape& shape, const glm::vec3& center, const glm::mat3& rot,
+                 const BodyCallback& fn, uint32_t layerMask) const;
+};
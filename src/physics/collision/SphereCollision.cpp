@@ -0,0 +1,108 @@
+#include "SphereCollision.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+#include <cmath>
+
+namespace {
+    // Keep near-touching pairs as speculative contacts, same as SAT
+    constexpr float CONTACT_THRESHOLD = 0.05f;
+
+    ContactManifold MakeManifold(const RigidBody& a, const RigidBody& b, const glm::vec3& normal,
+                                 const glm::vec3& point, float penetration) {
+        ContactManifold manifold;
+        manifold.a = (RigidBody*)&a;
+        manifold.b = (RigidBody*)&b;
+        manifold.hasCollision = true;
+        manifold.normal = normal;
+        manifold.penetration = penetration;
+        manifold.contacts.push_back({point, normal, penetration});
+        return manifold;
+    }
+}
+
+ContactManifold SphereCollision::DetectSpheres(const RigidBody& a, const RigidBody& b) {
+    float radiusA = a.AsSphere().radius;
+    float radiusB = b.AsSphere().radius;
+
+    glm::vec3 delta = b.position - a.position;
+    float distSq = glm::length2(delta);
+    float reach = radiusA + radiusB + CONTACT_THRESHOLD;
+    if (distSq > reach * reach) {
+        ContactManifold manifold;
+        manifold.a = (RigidBody*)&a;
+        manifold.b = (RigidBody*)&b;
+        return manifold;
+    }
+
+    float dist = std::sqrt(distSq);
+    glm::vec3 normal = dist > 1e-6f ? delta / dist : glm::vec3(0.0f, 1.0f, 0.0f);
+    return MakeManifold(a, b, normal, b.position - normal * radiusB, radiusA + radiusB - dist);
+}
+
+ContactManifold SphereCollision::DetectSphereBox(const RigidBody& sphere, const RigidBody& box, const glm::mat3& rotBox) {
+    glm::vec3 normal, pointOnBox;
+    float penetration;
+    if (!SphereVsBox(sphere, box, rotBox, normal, pointOnBox, penetration)) {
+        ContactManifold manifold;
+        manifold.a = (RigidBody*)&sphere;
+        manifold.b = (RigidBody*)&box;
+        return manifold;
+    }
+
+    return MakeManifold(sphere, box, normal, pointOnBox, penetration);
+}
+
+ContactManifold SphereCollision::DetectBoxSphere(const RigidBody& box, const glm::mat3& rotBox, const RigidBody& sphere) {
+    glm::vec3 normal, pointOnBox;
+    float penetration;
+    if (!SphereVsBox(sphere, box, rotBox, normal, pointOnBox, penetration)) {
+        ContactManifold manifold;
+        manifold.a = (RigidBody*)&box;
+        manifold.b = (RigidBody*)&sphere;
+        return manifold;
+    }
+
+    // Flip to box -> sphere; the contact point moves to the sphere's deepest point
+    glm::vec3 pointOnSphere = sphere.position + normal * sphere.AsSphere().radius;
+    return MakeManifold(box, sphere, -normal, pointOnSphere, penetration);
+}
+
+bool SphereCollision::SphereVsBox(const RigidBody& sphere, const RigidBody& box, const glm::mat3& rotBox,
+                                  glm::vec3& normal, glm::vec3& pointOnBox, float& penetration) {
+    float radius = sphere.AsSphere().radius;
+    glm::vec3 half = box.AsBox().halfExtents;
+
+    // Sphere center in the box's frame
+    glm::vec3 local = glm::transpose(rotBox) * (sphere.position - box.position);
+    glm::vec3 closest = glm::clamp(local, -half, half);
+    glm::vec3 delta = closest - local;
+    float distSq = glm::length2(delta);
+
+    if (distSq > 1e-12f) {
+        // Center outside the box: closest point on the surface
+        float reach = radius + CONTACT_THRESHOLD;
+        if (distSq > reach * reach) return false;
+
+        float dist = std::sqrt(distSq);
+        normal = rotBox * (delta / dist);
+        pointOnBox = box.position + rotBox * closest;
+        penetration = radius - dist;
+        return true;
+    }
+
+    // Center inside the box: push out through the nearest face
+    glm::vec3 faceDistance = half - glm::abs(local);
+    int axis = 0;
+    if (faceDistance.y < faceDistance[axis]) axis = 1;
+    if (faceDistance.z < faceDistance[axis]) axis = 2;
+
+    float side = local[axis] < 0.0f ? -1.0f : 1.0f;
+    glm::vec3 faceNormal = rotBox[axis] * side;
+    glm::vec3 facePoint = local;
+    facePoint[axis] = half[axis] * side;
+
+    normal = -faceNormal;
+    pointOnBox = box.position + rotBox * facePoint;
+    penetration = radius + faceDistance[axis];
+    return true;
+}
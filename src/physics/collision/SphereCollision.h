@@ -0,0 +1,18 @@
+#pragma once
+
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/ContactManifold.h"
+
+// Closed-form sphere contacts. Same conventions as SATCollision: the normal
+// points from A to B and each contact point lies on B's surface.
+class SphereCollision {
+public:
+    static ContactManifold DetectSpheres(const RigidBody& a, const RigidBody& b);
+    static ContactManifold DetectSphereBox(const RigidBody& sphere, const RigidBody& box, const glm::mat3& rotBox);
+    static ContactManifold DetectBoxSphere(const RigidBody& box, const glm::mat3& rotBox, const RigidBody& sphere);
+
+private:
+    // normal points from the sphere into the box
+    static bool SphereVsBox(const RigidBody& sphere, const RigidBody& box, const glm::mat3& rotBox,
+                            glm::vec3& normal, glm::vec3& pointOnBox, float& penetration);
+};
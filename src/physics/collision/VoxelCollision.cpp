@@ -0,0 +1,87 @@
+#include "VoxelCollision.h"
+#include "physics/collision/CollisionDispatch.h"
+#include "physics/collision/ContactReduction.h"
+#include "physics/collision/PairCache.h"
+#include "physics/collision/SATCollision.h"
+#include "physics/collision/SphereCollision.h"
+#include <vector>
+
+namespace {
+    // Keep near-touching pairs as speculative contacts, same as SAT
+    constexpr float CONTACT_THRESHOLD = 0.05f;
+
+    // Stand-in body for one merged box, reused across calls; one per thread.
+    // Built without an id, so workers reaching here don't shift later bodies' ids.
+    thread_local RigidBody proxy(BodyDesc{}, RigidBody::NO_ID);
+
+    // Capsules and hulls take whatever kernel the table has for box pairs.
+    // Emptied before every merged box, so it is only a scratch entry.
+    thread_local PairCache scratch;
+
+    template <class Kernel>
+    ContactManifold Collide(const RigidBody& voxels, const glm::mat3& rotVoxels,
+                            const RigidBody& body, const AABB& localBounds, Kernel&& kernel) {
+        ContactManifold manifold;
+        manifold.a = (RigidBody*)&voxels;
+        manifold.b = (RigidBody*)&body;
+
+        AABB query(localBounds.min - glm::vec3(CONTACT_THRESHOLD), localBounds.max + glm::vec3(CONTACT_THRESHOLD));
+        proxy.orientation = voxels.orientation;
+
+        std::vector<ContactPoint> contacts;
+        voxels.AsVoxelWorld().world->ForEachBox(query, [&](const VoxelBox& box) {
+            proxy.position = voxels.position + rotVoxels * box.center;
+            proxy.shape = BoxShape(box.halfExtents);
+            ContactManifold m = kernel(proxy);
+            if (!m.hasCollision) return;
+            if (!manifold.hasCollision || m.penetration > manifold.penetration) {
+                manifold.hasCollision = true;
+                manifold.normal = m.normal;
+                manifold.penetration = m.penetration;
+            }
+            contacts.insert(contacts.end(), m.contacts.begin(), m.contacts.end());
+        });
+
+        if (manifold.hasCollision) {
+            ContactReduction::Reduce(contacts, manifold.normal);
+            manifold.contacts = std::move(contacts);
+        }
+        return manifold;
+    }
+
+    AABB LocalBounds(const RigidBody& voxels, const glm::mat3& rotVoxels, const AABB& worldBounds) {
+        glm::mat3 invRot = glm::transpose(rotVoxels);
+        glm::vec3 center = invRot * ((worldBounds.min + worldBounds.max) * 0.5f - voxels.position);
+        glm::vec3 half = (worldBounds.max - worldBounds.min) * 0.5f;
+        glm::vec3 localHalf = glm::abs(invRot[0]) * half.x + glm::abs(invRot[1]) * half.y + glm::abs(invRot[2]) * half.z;
+        return AABB(center - localHalf, center + localHalf);
+    }
+}
+
+ContactManifold VoxelCollision::DetectBox(const RigidBody& voxels, const glm::mat3& rotVoxels,
+                                          const RigidBody& box, const glm::mat3& rotBox) {
+    AABB bounds = LocalBounds(voxels, rotVoxels, box.AsBox().ComputeAABB(box.position, rotBox));
+    return Collide(voxels, rotVoxels, box, bounds, [&](const RigidBody& voxelBox) {
+        // Merged boxes change with every edit, so there's nothing worth caching per pair
+        PairCacheEntry scratch;
+        return SATCollision::DetectCollision(voxelBox, rotVoxels, box, rotBox, scratch);
+    });
+}
+
+ContactManifold VoxelCollision::DetectSphere(const RigidBody& voxels, const glm::mat3& rotVoxels,
+                                             const RigidBody& sphere) {
+    float radius = sphere.AsSphere().radius;
+    AABB bounds = LocalBounds(voxels, rotVoxels, AABB(sphere.position - glm::vec3(radius), sphere.position + glm::vec3(radius)));
+    return Collide(voxels, rotVoxels, sphere, bounds, [&](const RigidBody& voxelBox) {
+        return SphereCollision::DetectBoxSphere(voxelBox, rotVoxels, sphere);
+    });
+}
+
+ContactManifold VoxelCollision::DetectConvex(const RigidBody& voxels, const glm::mat3& rotVoxels,
+                                             const RigidBody& body, const glm::mat3& rotBody) {
+    AABB bounds = LocalBounds(voxels, rotVoxels, body.ComputeAABB(rotBody));
+    return Collide(voxels, rotVoxels, body, bounds, [&](const RigidBody& voxelBox) {
+        scratch.Clear();
+        return CollisionDispatch::Detect(voxelBox, rotVoxels, body, rotBody, scratch);
+    });
+}
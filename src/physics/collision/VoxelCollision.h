@@ -0,0 +1,19 @@
+#pragma once
+
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/ContactManifold.h"
+
+// Box, sphere, capsule and hull against a voxel world. Each merged voxel box
+// near the body goes through the existing box-box SAT / box-sphere kernels,
+// or the dispatch table's box kernel for capsules and hulls, and the
+// contacts are pooled into one manifold. manifold.a is the voxel world.
+class VoxelCollision {
+public:
+    static ContactManifold DetectBox(const RigidBody& voxels, const glm::mat3& rotVoxels,
+                                     const RigidBody& box, const glm::mat3& rotBox);
+    static ContactManifold DetectSphere(const RigidBody& voxels, const glm::mat3& rotVoxels,
+                                        const RigidBody& sphere);
+    // Capsules and hulls: box-capsule through GJK/EPA, box-hull through HullCollision
+    static ContactManifold DetectConvex(const RigidBody& voxels, const glm::mat3& rotVoxels,
+                                        const RigidBody& body, const glm::mat3& rotBody);
+};
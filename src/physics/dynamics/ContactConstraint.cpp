@@ -0,0 +1,33 @@
+#include "ContactConstraint.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/quaternion.hpp>
+
+void ContactConstraint::Refresh(const glm::mat3& rotA, const glm::mat3& rotB) {
+    glm::vec3 anchorA = a->position + rotA * localAnchorA;
+    glm::vec3 anchorB = b->position + rotB * localAnchorB;
+
+    point = anchorB;
+    penetration = glm::dot(anchorA - anchorB, normal);
+}
+
+void ContactConstraint::AppendFromManifold(const ContactManifold& manifold, std::vector<ContactConstraint>& out) {
+    if (!manifold.hasCollision) return;
+
+    glm::mat3 invRotA = glm::transpose(glm::toMat3(manifold.a->orientation));
+    glm::mat3 invRotB = glm::transpose(glm::toMat3(manifold.b->orientation));
+
+    for (const ContactPoint& cp : manifold.contacts) {
+        // cp.point is B's corner; A's surface lies penetration further along the normal
+        glm::vec3 surfaceA = cp.point + cp.normal * cp.penetration;
+
+        ContactConstraint c;
+        c.a = manifold.a;
+        c.b = manifold.b;
+        c.localAnchorA = invRotA * (surfaceA - manifold.a->position);
+        c.localAnchorB = invRotB * (cp.point - manifold.b->position);
+        c.normal = cp.normal;
+        c.point = cp.point;
+        c.penetration = cp.penetration;
+        out.push_back(c);
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/ContactManifold.h"
+
+// A contact point captured by narrowphase once per frame. Each substep only
+// re-evaluates the separation from the bodies' current poses (TGS-soft style)
+// instead of rerunning SAT and rebuilding the manifold.
+struct ContactConstraint {
+    RigidBody* a = nullptr;
+    RigidBody* b = nullptr;
+    glm::vec3 localAnchorA;   // Point on A's surface, in A's body frame
+    glm::vec3 localAnchorB;   // Penetrating point of B, in B's body frame
+    glm::vec3 normal;         // World normal from A to B, fixed for the frame
+    glm::vec3 point;          // Current world contact point (on B)
+    float penetration = 0.0f; // Current penetration along normal
+
+    // Recompute point and penetration from the current body poses
+    void Refresh(const glm::mat3& rotA, const glm::mat3& rotB);
+
+    static void AppendFromManifold(const ContactManifold& manifold, std::vector<ContactConstraint>& out);
+};
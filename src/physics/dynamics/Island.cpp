@@ -0,0 +1,57 @@
+#include "Island.h"
+#include <numeric>
+
+int IslandBuilder::Find(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];  // Path halving
+        i = parent[i];
+    }
+    return i;
+}
+
+void IslandBuilder::Group(const std::vector<RigidBody>& bodies,
+                          const std::vector<BodyPair>& pairs,
+                          std::vector<Island>& outIslands,
+                          std::vector<int>& islandOfBody) {
+    outIslands.clear();
+
+    std::vector<int> parent(bodies.size());
+    std::iota(parent.begin(), parent.end(), 0);
+
+    for (const BodyPair& pair : pairs) {
+        if (bodies[pair.a].isStatic || bodies[pair.b].isStatic) continue;
+        int rootA = Find(parent, pair.a);
+        int rootB = Find(parent, pair.b);
+        if (rootA != rootB) parent[rootB] = rootA;
+    }
+
+    // Map each root to an island slot, in body order so islands come out deterministic
+    std::vector<int> islandOf(bodies.size(), -1);
+    islandOfBody.assign(bodies.size(), -1);
+    for (int i = 0; i < (int)bodies.size(); ++i) {
+        if (bodies[i].isStatic) continue;
+
+        int root = Find(parent, i);
+        if (islandOf[root] < 0) {
+            islandOf[root] = (int)outIslands.size();
+            outIslands.emplace_back();
+            outIslands.back().isSleeping = true;
+        }
+
+        islandOfBody[i] = islandOf[root];
+        Island& island = outIslands[islandOf[root]];
+        island.bodies.push_back(i);
+        island.isSleeping = island.isSleeping && bodies[i].isSleeping;
+    }
+}
+
+void IslandBuilder::AssignPairs(const std::vector<RigidBody>& bodies,
+                                const std::vector<BodyPair>& pairs,
+                                const std::vector<int>& islandOfBody,
+                                std::vector<Island>& islands) {
+    for (const BodyPair& pair : pairs) {
+        int dynamicBody = bodies[pair.a].isStatic ? pair.b : pair.a;
+        if (bodies[dynamicBody].isStatic) continue;
+        islands[islandOfBody[dynamicBody]].pairs.push_back(pair);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+#include "physics/bodies/RigidBody.h"
+#include "physics/collision/Broadphase.h"
+
+// A group of dynamic bodies connected through broadphase pairs.
+// Static bodies never join islands, so a floor doesn't merge everything into one.
+struct Island {
+    std::vector<int> bodies;       // Dynamic body indices
+    std::vector<BodyPair> pairs;   // Pairs with at least one body in this island
+    bool isSleeping = false;       // Every body in the island is asleep
+};
+
+class IslandBuilder {
+public:
+    // Two steps, so the grouping can start before static pairs are found.
+    // Group only needs the dynamic-dynamic pairs; islandOfBody is -1 for
+    // static bodies. AssignPairs then hands every pair to its island.
+    static void Group(const std::vector<RigidBody>& bodies,
+                      const std::vector<BodyPair>& pairs,
+                      std::vector<Island>& outIslands,
+                      std::vector<int>& islandOfBody);
+    static void AssignPairs(const std::vector<RigidBody>& bodies,
+                            const std::vector<BodyPair>& pairs,
+                            const std::vector<int>& islandOfBody,
+                            std::vector<Island>& islands);
+
+private:
+    static int Find(std::vector<int>& parent, int i);
+};
@@ -1,10 +1,9 @@
 // src/physics/shapes/BoxShape.h
 #pragma once
 #include <glm/glm.hpp>
-#include "Shape.h"
 #include "../collision/AABB.h"
 
-class BoxShape : public Shape {
+class BoxShape {
 public:
     glm::vec3 halfExtents;
 
@@ -15,7 +14,22 @@ public:
         return halfExtents * 2.0f;
     }
 
-    AABB ComputeAABB(const glm::vec3& position) const override {
-        return AABB(position - halfExtents, position + halfExtents);
+    // Support point in local space; boxes have no rounding margin
+    glm::vec3 Support(const glm::vec3& dir) const {
+        return glm::vec3(dir.x >= 0.0f ? halfExtents.x : -halfExtents.x,
+                         dir.y >= 0.0f ? halfExtents.y : -halfExtents.y,
+                         dir.z >= 0.0f ? halfExtents.z : -halfExtents.z);
+    }
+
+    float GetMargin() const {
+        return 0.0f;
+    }
+
+    AABB ComputeAABB(const glm::vec3& position, const glm::mat3& rot) const {
+        glm::vec3 worldHalfExtents =
+            glm::abs(rot[0]) * halfExtents.x +
+            glm::abs(rot[1]) * halfExtents.y +
+            glm::abs(rot[2]) * halfExtents.z;
+        return AABB(position - worldHalfExtents, position + worldHalfExtents);
     }
 };
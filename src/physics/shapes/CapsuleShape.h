@@ -0,0 +1,32 @@
+// src/physics/shapes/CapsuleShape.h
+#pragma once
+#include <glm/glm.hpp>
+#include "../collision/AABB.h"
+
+// Segment along local Y from -halfHeight to +halfHeight, inflated by radius
+class CapsuleShape {
+public:
+    float radius;
+    float halfHeight;
+
+    CapsuleShape(float radius, float halfHeight)
+        : radius(radius), halfHeight(halfHeight) {}
+
+    glm::vec3 GetSize() const {
+        return glm::vec3(radius * 2.0f, (halfHeight + radius) * 2.0f, radius * 2.0f);
+    }
+
+    // The core is the segment; the radius is applied as a margin
+    glm::vec3 Support(const glm::vec3& dir) const {
+        return glm::vec3(0.0f, dir.y >= 0.0f ? halfHeight : -halfHeight, 0.0f);
+    }
+
+    float GetMargin() const {
+        return radius;
+    }
+
+    AABB ComputeAABB(const glm::vec3& position, const glm::mat3& rot) const {
+        glm::vec3 extent = glm::abs(rot[1]) * halfHeight + glm::vec3(radius);
+        return AABB(position - extent, position + extent);
+    }
+};
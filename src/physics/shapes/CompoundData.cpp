@@ -0,0 +1,132 @@
+#include "CompoundData.h"
+#include <algorithm>
+#include <cfloat>
+#include <iostream>
+#include <numeric>
+
+namespace {
+    constexpr float PI = 3.14159265358979f;
+    constexpr size_t MAX_CHILDREN = 1u << 16;
+
+    // Volume and inertia per unit mass about the child's own center, in its own frame
+    void ChildMass(const ChildShape& shape, float& volume, glm::mat3& inertia) {
+        if (const BoxShape* box = std::get_if<BoxShape>(&shape)) {
+            glm::vec3 h = box->halfExtents;
+            volume = 8.0f * h.x * h.y * h.z;
+            inertia = glm::mat3(0.0f);
+            inertia[0][0] = (h.y * h.y + h.z * h.z) / 3.0f;
+            inertia[1][1] = (h.x * h.x + h.z * h.z) / 3.0f;
+            inertia[2][2] = (h.x * h.x + h.y * h.y) / 3.0f;
+        } else if (const SphereShape* sphere = std::get_if<SphereShape>(&shape)) {
+            float r = sphere->radius;
+            volume = (4.0f / 3.0f) * PI * r * r * r;
+            inertia = glm::mat3(0.4f * r * r);
+        } else if (const CapsuleShape* capsule = std::get_if<CapsuleShape>(&shape)) {
+            // Same split as RigidBody::ComputeInertia, for unit mass
+            float r = capsule->radius;
+            float h = capsule->halfHeight;
+            float cylinderVolume = PI * r * r * 2.0f * h;
+            float capsVolume = (4.0f / 3.0f) * PI * r * r * r;
+            volume = cylinderVolume + capsVolume;
+            float mc = cylinderVolume / volume;
+            float ms = 1.0f - mc;
+            float iy = mc * r * r * 0.5f + ms * 0.4f * r * r;
+            float ixz = mc * (r * r * 0.25f + h * h / 3.0f) + ms * (0.4f * r * r + h * h + 0.75f * h * r);
+            inertia = glm::mat3(0.0f);
+            inertia[0][0] = ixz;
+            inertia[1][1] = iy;
+            inertia[2][2] = ixz;
+        } else {
+            const HullData& hull = *std::get<ConvexHullShape>(shape).hull;
+            volume = hull.volume;
+            inertia = hull.inertiaPerMass;
+        }
+    }
+}
+
+std::shared_ptr<const CompoundData> CompoundData::Build(std::vector<CompoundChild> children) {
+    if (children.empty() || children.size() > MAX_CHILDREN) {
+        std::cerr << "CompoundData::Build: bad child count\n";
+        return nullptr;
+    }
+
+    auto compound = std::make_shared<CompoundData>();
+    compound->children = std::move(children);
+    compound->ComputeMassProperties();
+    compound->BuildTree();
+    return compound;
+}
+
+void CompoundData::ComputeMassProperties() {
+    std::vector<float> masses(children.size());
+    std::vector<glm::mat3> localInertia(children.size());
+    float totalMass = 0.0f;
+    glm::vec3 weightedCenter(0.0f);
+    for (size_t i = 0; i < children.size(); i++) {
+        float volume;
+        ChildMass(children[i].shape, volume, localInertia[i]);
+        masses[i] = volume * children[i].density;
+        totalMass += masses[i];
+        weightedCenter += children[i].position * masses[i];
+    }
+    centerOfMass = totalMass > 0.0f ? weightedCenter / totalMass : glm::vec3(0.0f);
+
+    // Rotate each child's tensor into the compound frame, then shift it to
+    // the shared center of mass (parallel axis theorem)
+    glm::mat3 inertia(0.0f);
+    for (size_t i = 0; i < children.size(); i++) {
+        CompoundChild& child = children[i];
+        child.position -= centerOfMass;
+        glm::mat3 rot = glm::mat3_cast(child.orientation);
+        glm::vec3 d = child.position;
+        inertia += (rot * localInertia[i] * glm::transpose(rot) +
+                    glm::mat3(glm::dot(d, d)) - glm::outerProduct(d, d)) * masses[i];
+    }
+    inertiaPerMass = totalMass > 0.0f ? inertia * (1.0f / totalMass) : glm::mat3(1.0f);
+}
+
+void CompoundData::BuildTree() {
+    std::vector<AABB> bounds(children.size());
+    std::vector<uint32_t> order(children.size());
+    std::iota(order.begin(), order.end(), 0);
+    boundsMin = glm::vec3(FLT_MAX);
+    boundsMax = glm::vec3(-FLT_MAX);
+    for (size_t i = 0; i < children.size(); i++) {
+        bounds[i] = children[i].ComputeAABB();
+        boundsMin = glm::min(boundsMin, bounds[i].min);
+        boundsMax = glm::max(boundsMax, bounds[i].max);
+    }
+
+    // Depth-first with median splits, one child per leaf
+    nodes.clear();
+    nodes.reserve(children.size() * 2);
+    auto build = [&](auto& self, uint32_t begin, uint32_t end) -> uint32_t {
+        uint32_t index = (uint32_t)nodes.size();
+        nodes.emplace_back();
+
+        AABB box(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+        for (uint32_t i = begin; i < end; i++) {
+            box.min = glm::min(box.min, bounds[order[i]].min);
+            box.max = glm::max(box.max, bounds[order[i]].max);
+        }
+        nodes[index].bounds = box;
+
+        if (end - begin == 1) {
+            nodes[index].payload = CompoundNode::LEAF_FLAG | order[begin];
+            return index;
+        }
+
+        glm::vec3 extent = box.max - box.min;
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        uint32_t mid = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](uint32_t x, uint32_t y) {
+            return bounds[x].min[axis] + bounds[x].max[axis] < bounds[y].min[axis] + bounds[y].max[axis];
+        });
+
+        self(self, begin, mid);
+        uint32_t right = self(self, mid, end);
+        nodes[index].payload = right;
+        return index;
+    };
+    build(build, 0, (uint32_t)children.size());
+}
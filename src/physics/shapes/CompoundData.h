@@ -0,0 +1,85 @@
+// src/physics/shapes/CompoundData.h
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <variant>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "BoxShape.h"
+#include "SphereShape.h"
+#include "CapsuleShape.h"
+#include "ConvexHullShape.h"
+#include "../collision/AABB.h"
+
+// Convex pieces a compound can be built from
+using ChildShape = std::variant<BoxShape, SphereShape, CapsuleShape, ConvexHullShape>;
+
+struct CompoundChild {
+    ChildShape shape;
+    glm::vec3 position = glm::vec3(0.0f);  // In the compound's frame
+    glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    float density = 1.0f;  // Relative; only the mass split between children uses it
+
+    AABB ComputeAABB() const {
+        glm::mat3 rot = glm::mat3_cast(orientation);
+        return std::visit([&](const auto& s) { return s.ComputeAABB(position, rot); }, shape);
+    }
+};
+
+// Same layout idea as MeshBVHNode, with float bounds since children are few
+struct CompoundNode {
+    AABB bounds;
+    // Interior: index of the right child (the left child is the next node).
+    // Leaf: LEAF_FLAG | child index.
+    uint32_t payload;
+
+    static constexpr uint32_t LEAF_FLAG = 0x80000000u;
+
+    bool IsLeaf() const { return (payload & LEAF_FLAG) != 0; }
+    uint32_t RightChild() const { return payload; }
+    uint32_t Child() const { return payload & ~LEAF_FLAG; }
+};
+
+// Rigid assembly of convex children sharing one body and one broadphase
+// entry. Built once and shared; children are recentered on the combined
+// center of mass.
+class CompoundData {
+public:
+    std::vector<CompoundChild> children;
+    std::vector<CompoundNode> nodes;
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+    glm::vec3 centerOfMass;    // Where the original frame's COM was, before recentering
+    glm::mat3 inertiaPerMass;  // About the center of mass; scale by the body's mass
+
+    static std::shared_ptr<const CompoundData> Build(std::vector<CompoundChild> children);
+
+    // Children whose bounds overlap box (compound frame)
+    template <class Fn>
+    void ForEachChild(const AABB& box, Fn&& fn) const {
+        uint32_t stack[MAX_DEPTH];
+        int top = 0;
+        uint32_t index = 0;
+        for (;;) {
+            const CompoundNode& node = nodes[index];
+            if (node.bounds.Overlaps(box)) {
+                if (node.IsLeaf()) {
+                    fn(node.Child(), children[node.Child()]);
+                } else {
+                    stack[top++] = node.RightChild();
+                    index++;
+                    continue;
+                }
+            }
+            if (top == 0) break;
+            index = stack[--top];
+        }
+    }
+
+private:
+    static constexpr int MAX_DEPTH = 32;
+
+    void ComputeMassProperties();
+    void BuildTree();
+};
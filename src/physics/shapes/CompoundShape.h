@@ -0,0 +1,31 @@
+// src/physics/shapes/CompoundShape.h
+#pragma once
+#include <memory>
+#include <glm/glm.hpp>
+#include "CompoundData.h"
+#include "../collision/AABB.h"
+
+// Several convex children on one body. The broadphase only sees the
+// overall bounds; narrowphase walks the compound's own BVH.
+class CompoundShape {
+public:
+    std::shared_ptr<const CompoundData> compound;
+
+    explicit CompoundShape(std::shared_ptr<const CompoundData> compound)
+        : compound(std::move(compound)) {}
+
+    glm::vec3 GetSize() const {
+        return compound->boundsMax - compound->boundsMin;
+    }
+
+    AABB ComputeAABB(const glm::vec3& position, const glm::mat3& rot) const {
+        glm::vec3 center = (compound->boundsMin + compound->boundsMax) * 0.5f;
+        glm::vec3 half = (compound->boundsMax - compound->boundsMin) * 0.5f;
+        glm::vec3 worldCenter = position + rot * center;
+        glm::vec3 worldHalf =
+            glm::abs(rot[0]) * half.x +
+            glm::abs(rot[1]) * half.y +
+            glm::abs(rot[2]) * half.z;
+        return AABB(worldCenter - worldHalf, worldCenter + worldHalf);
+    }
+};
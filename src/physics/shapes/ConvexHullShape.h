@@ -0,0 +1,39 @@
+// src/physics/shapes/ConvexHullShape.h
+#pragma once
+#include <memory>
+#include <glm/glm.hpp>
+#include "HullData.h"
+#include "../collision/AABB.h"
+
+// Instances only hold a reference; the polytope lives in the ShapeRegistry
+class ConvexHullShape {
+public:
+    std::shared_ptr<const HullData> hull;
+
+    explicit ConvexHullShape(std::shared_ptr<const HullData> hull)
+        : hull(std::move(hull)) {}
+
+    glm::vec3 GetSize() const {
+        return hull->boundsMax - hull->boundsMin;
+    }
+
+    glm::vec3 Support(const glm::vec3& dir) const {
+        return hull->Support(dir);
+    }
+
+    float GetMargin() const {
+        return 0.0f;
+    }
+
+    // Rotated local bounds; slightly loose but avoids touching every vertex
+    AABB ComputeAABB(const glm::vec3& position, const glm::mat3& rot) const {
+        glm::vec3 center = (hull->boundsMin + hull->boundsMax) * 0.5f;
+        glm::vec3 half = (hull->boundsMax - hull->boundsMin) * 0.5f;
+        glm::vec3 worldCenter = position + rot * center;
+        glm::vec3 worldHalf =
+            glm::abs(rot[0]) * half.x +
+            glm::abs(rot[1]) * half.y +
+            glm::abs(rot[2]) * half.z;
+        return AABB(worldCenter - worldHalf, worldCenter + worldHalf);
+    }
+};
@@ -0,0 +1,128 @@
+#include "HeightfieldData.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    constexpr float CONVEX_EPSILON = 1e-4f;  // Relative bend below which an edge counts as flat
+    constexpr int MAX_GRID_SIDE = 1 << 15;
+
+    HeightRange Merge(const HeightRange& a, const HeightRange& b) {
+        return {std::min(a.min, b.min), std::max(a.max, b.max)};
+    }
+}
+
+std::shared_ptr<const HeightfieldData> HeightfieldData::Build(int columns, int rows, float cellSize,
+                                                              const std::vector<float>& heights) {
+    if (columns < 2 || rows < 2 || columns > MAX_GRID_SIDE || rows > MAX_GRID_SIDE ||
+        cellSize <= 0.0f || heights.size() != (size_t)columns * rows) {
+        std::cerr << "HeightfieldData::Build: bad grid\n";
+        return nullptr;
+    }
+
+    auto field = std::make_shared<HeightfieldData>();
+    field->columns = columns;
+    field->rows = rows;
+    field->cellSize = cellSize;
+    field->heights = heights;
+
+    auto [lowest, highest] = std::minmax_element(heights.begin(), heights.end());
+    glm::vec2 half(0.5f * cellSize * (columns - 1), 0.5f * cellSize * (rows - 1));
+    field->boundsMin = glm::vec3(-half.x, *lowest, -half.y);
+    field->boundsMax = glm::vec3(half.x, *highest, half.y);
+
+    MipLevel base{columns - 1, rows - 1, {}};
+    base.ranges.resize((size_t)base.width * base.depth);
+    for (int z = 0; z < base.depth; z++) {
+        for (int x = 0; x < base.width; x++) {
+            float h00 = heights[z * columns + x];
+            float h10 = heights[z * columns + x + 1];
+            float h01 = heights[(z + 1) * columns + x];
+            float h11 = heights[(z + 1) * columns + x + 1];
+            base.ranges[z * base.width + x] = {std::min(std::min(h00, h10), std::min(h01, h11)),
+                                               std::max(std::max(h00, h10), std::max(h01, h11))};
+        }
+    }
+    field->mips.push_back(std::move(base));
+
+    while (field->mips.back().width > 1 || field->mips.back().depth > 1) {
+        const MipLevel& below = field->mips.back();
+        MipLevel level{(below.width + 1) / 2, (below.depth + 1) / 2, {}};
+        level.ranges.resize((size_t)level.width * level.depth);
+        for (int z = 0; z < level.depth; z++) {
+            for (int x = 0; x < level.width; x++) {
+                int bx = std::min(x * 2 + 1, below.width - 1);
+                int bz = std::min(z * 2 + 1, below.depth - 1);
+                HeightRange range = below.ranges[z * 2 * below.width + x * 2];
+                range = Merge(range, below.ranges[z * 2 * below.width + bx]);
+                range = Merge(range, below.ranges[bz * below.width + x * 2]);
+                range = Merge(range, below.ranges[bz * below.width + bx]);
+                level.ranges[z * level.width + x] = range;
+            }
+        }
+        field->mips.push_back(std::move(level));
+    }
+    return field;
+}
+
+bool HeightfieldData::CellSpan(const AABB& box, int& x0, int& z0, int& x1, int& z1) const {
+    if (box.max.y < boundsMin.y || box.min.y > boundsMax.y) return false;
+
+    float fx0 = std::floor((box.min.x - boundsMin.x) / cellSize);
+    float fz0 = std::floor((box.min.z - boundsMin.z) / cellSize);
+    float fx1 = std::floor((box.max.x - boundsMin.x) / cellSize);
+    float fz1 = std::floor((box.max.z - boundsMin.z) / cellSize);
+    if (fx1 < 0.0f || fz1 < 0.0f || fx0 >= CellColumns() || fz0 >= CellRows()) return false;
+
+    x0 = (int)std::max(fx0, 0.0f);
+    z0 = (int)std::max(fz0, 0.0f);
+    x1 = (int)std::min(fx1, (float)(CellColumns() - 1));
+    z1 = (int)std::min(fz1, (float)(CellRows() - 1));
+    return true;
+}
+
+HeightRange HeightfieldData::RangeOver(int x0, int z0, int x1, int z1) const {
+    // Coarsest needed level is the first where the span fits in 2x2 texels
+    int level = 0;
+    while (level + 1 < (int)mips.size() && ((x1 >> level) - (x0 >> level) > 1 || (z1 >> level) - (z0 >> level) > 1)) {
+        level++;
+    }
+    const MipLevel& mip = mips[level];
+    int ax = x0 >> level, az = z0 >> level;
+    int bx = x1 >> level, bz = z1 >> level;
+    HeightRange range = mip.ranges[az * mip.width + ax];
+    range = Merge(range, mip.ranges[az * mip.width + bx]);
+    range = Merge(range, mip.ranges[bz * mip.width + ax]);
+    range = Merge(range, mip.ranges[bz * mip.width + bx]);
+    return range;
+}
+
+void HeightfieldData::CellTriangles(int x, int z, glm::vec3 (&triangles)[2][3], uint8_t (&convexEdges)[2]) const {
+    glm::vec3 p00 = Vertex(x, z);
+    glm::vec3 p10 = Vertex(x + 1, z);
+    glm::vec3 p01 = Vertex(x, z + 1);
+    glm::vec3 p11 = Vertex(x + 1, z + 1);
+    triangles[0][0] = p00; triangles[0][1] = p01; triangles[0][2] = p11;
+    triangles[1][0] = p00; triangles[1][1] = p11; triangles[1][2] = p10;
+
+    // Far vertex of the triangle across each edge, if the grid has one
+    bool hasFar[2][3] = {
+        {x > 0, z + 1 < CellRows(), true},
+        {true, x + 1 < CellColumns(), z > 0},
+    };
+    glm::vec3 far[2][3] = {
+        {hasFar[0][0] ? Vertex(x - 1, z) : p00, hasFar[0][1] ? Vertex(x + 1, z + 2) : p00, p10},
+        {p01, hasFar[1][1] ? Vertex(x + 2, z + 1) : p00, hasFar[1][2] ? Vertex(x, z - 1) : p00},
+    };
+
+    for (int i = 0; i < 2; i++) {
+        const glm::vec3 (&v)[3] = triangles[i];
+        glm::vec3 n = glm::cross(v[1] - v[0], v[2] - v[0]);
+        float scale = glm::length(n);
+        convexEdges[i] = 0;
+        for (int j = 0; j < 3; j++) {
+            bool convex = !hasFar[i][j] || glm::dot(n, far[i][j] - v[0]) < -CONVEX_EPSILON * scale;
+            if (convex) convexEdges[i] |= (uint8_t)(1u << j);
+        }
+    }
+}
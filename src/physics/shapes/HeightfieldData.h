@@ -0,0 +1,56 @@
+// src/physics/shapes/HeightfieldData.h
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../collision/AABB.h"
+
+struct HeightRange {
+    float min;
+    float max;
+};
+
+// Regular grid of heights in the local XZ plane, centered on the origin.
+// Nothing is triangulated up front: contact code asks for the two triangles
+// of each cell it touches, so memory is one float per sample plus the mips.
+class HeightfieldData {
+public:
+    int columns = 0;  // Samples along X
+    int rows = 0;     // Samples along Z
+    float cellSize = 1.0f;
+    std::vector<float> heights;  // rows * columns, row-major (z * columns + x)
+    // Level 0 holds one range per cell; each level above halves both sides
+    struct MipLevel {
+        int width;
+        int depth;
+        std::vector<HeightRange> ranges;
+    };
+    std::vector<MipLevel> mips;
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+
+    static std::shared_ptr<const HeightfieldData> Build(int columns, int rows, float cellSize,
+                                                        const std::vector<float>& heights);
+
+    int CellColumns() const { return columns - 1; }
+    int CellRows() const { return rows - 1; }
+
+    glm::vec3 Vertex(int x, int z) const {
+        return glm::vec3(boundsMin.x + x * cellSize, heights[z * columns + x], boundsMin.z + z * cellSize);
+    }
+
+    // Inclusive cell span under box (local frame); false if it misses the grid
+    bool CellSpan(const AABB& box, int& x0, int& z0, int& x1, int& z1) const;
+
+    // Conservative height range over a cell span, read from at most 2x2 mip texels
+    HeightRange RangeOver(int x0, int z0, int x1, int z1) const;
+
+    const HeightRange& CellRange(int x, int z) const {
+        return mips[0].ranges[z * mips[0].width + x];
+    }
+
+    // Cell split along its (x, z)-(x+1, z+1) diagonal, both triangles facing +Y.
+    // Bit j of convexEdges[i] is set when edge j of triangle i is convex or open.
+    void CellTriangles(int x, int z, glm::vec3 (&triangles)[2][3], uint8_t (&convexEdges)[2]) const;
+};
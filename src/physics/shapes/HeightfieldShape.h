@@ -0,0 +1,31 @@
+// src/physics/shapes/HeightfieldShape.h
+#pragma once
+#include <memory>
+#include <glm/glm.hpp>
+#include "HeightfieldData.h"
+#include "../collision/AABB.h"
+
+// Static terrain. Like TriangleMeshShape it never goes through GJK; a body's
+// AABB maps straight to the cells under it.
+class HeightfieldShape {
+public:
+    std::shared_ptr<const HeightfieldData> field;
+
+    explicit HeightfieldShape(std::shared_ptr<const HeightfieldData> field)
+        : field(std::move(field)) {}
+
+    glm::vec3 GetSize() const {
+        return field->boundsMax - field->boundsMin;
+    }
+
+    AABB ComputeAABB(const glm::vec3& position, const glm::mat3& rot) const {
+        glm::vec3 center = (field->boundsMin + field->boundsMax) * 0.5f;
+        glm::vec3 half = (field->boundsMax - field->boundsMin) * 0.5f;
+        glm::vec3 worldCenter = position + rot * center;
+        glm::vec3 worldHalf =
+            glm::abs(rot[0]) * half.x +
+            glm::abs(rot[1]) * half.y +
+            glm::abs(rot[2]) * half.z;
+        return AABB(worldCenter - worldHalf, worldCenter + worldHalf);
+    }
+};
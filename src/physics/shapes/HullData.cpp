@@ -0,0 +1,311 @@
+#include "HullData.h"
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/norm.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+    constexpr float RELATIVE_EPSILON = 1e-5f;   // Plane tolerance as a fraction of the cloud size
+    constexpr float COPLANAR_COS = 0.9999f;     // Triangles this aligned merge into one face
+
+    struct BuildTri {
+        int v[3];
+        glm::vec3 n;
+        float d;
+        bool alive = true;
+    };
+
+    uint64_t EdgeKey(int a, int b) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+    }
+
+    BuildTri MakeTri(const std::vector<glm::vec3>& p, int a, int b, int c) {
+        BuildTri t;
+        t.v[0] = a;
+        t.v[1] = b;
+        t.v[2] = c;
+        glm::vec3 n = glm::cross(p[b] - p[a], p[c] - p[a]);
+        float length = glm::length(n);
+        t.n = length > 0.0f ? n / length : glm::vec3(0.0f);
+        t.d = glm::dot(t.n, p[a]);
+        return t;
+    }
+
+    // Triangle hull of the cloud, outward-wound. Empty on degenerate input.
+    std::vector<BuildTri> BuildTriangles(const std::vector<glm::vec3>& p, float eps) {
+        int n = (int)p.size();
+
+        int i0 = 0;
+        for (int i = 1; i < n; i++) if (p[i].x < p[i0].x) i0 = i;
+        int i1 = i0;
+        float best = 0.0f;
+        for (int i = 0; i < n; i++) {
+            float d = glm::length2(p[i] - p[i0]);
+            if (d > best) { best = d; i1 = i; }
+        }
+        int i2 = i0;
+        best = 0.0f;
+        for (int i = 0; i < n; i++) {
+            float d = glm::length2(glm::cross(p[i] - p[i0], p[i1] - p[i0]));
+            if (d > best) { best = d; i2 = i; }
+        }
+        int i3 = i0;
+        best = 0.0f;
+        glm::vec3 baseNormal = glm::normalize(glm::cross(p[i1] - p[i0], p[i2] - p[i0]));
+        for (int i = 0; i < n; i++) {
+            float d = std::abs(glm::dot(p[i] - p[i0], baseNormal));
+            if (d > best) { best = d; i3 = i; }
+        }
+        if (i1 == i0 || i2 == i0 || best <= eps) return {};
+
+        std::vector<BuildTri> tris;
+        glm::vec3 center = (p[i0] + p[i1] + p[i2] + p[i3]) * 0.25f;
+        int seed[4][3] = {{i0, i1, i2}, {i0, i3, i1}, {i0, i2, i3}, {i1, i3, i2}};
+        for (auto& s : seed) {
+            BuildTri t = MakeTri(p, s[0], s[1], s[2]);
+            if (glm::dot(t.n, center) - t.d > 0.0f) t = MakeTri(p, s[0], s[2], s[1]);
+            tris.push_back(t);
+        }
+
+        std::unordered_map<uint64_t, int> edgeSet;
+        for (int i = 0; i < n; i++) {
+            if (i == i0 || i == i1 || i == i2 || i == i3) continue;
+
+            edgeSet.clear();
+            bool anyVisible = false;
+            for (BuildTri& t : tris) {
+                if (!t.alive || glm::dot(t.n, p[i]) - t.d <= eps) continue;
+                t.alive = false;
+                anyVisible = true;
+                for (int k = 0; k < 3; k++) edgeSet[EdgeKey(t.v[k], t.v[(k + 1) % 3])] = 1;
+            }
+            if (!anyVisible) continue;
+
+            // Horizon edges belong to exactly one removed triangle
+            for (const auto& [key, unused] : edgeSet) {
+                int a = (int)(key >> 32);
+                int b = (int)(key & 0xffffffffu);
+                if (edgeSet.count(EdgeKey(b, a))) continue;
+                tris.push_back(MakeTri(p, a, b, i));
+            }
+        }
+
+        tris.erase(std::remove_if(tris.begin(), tris.end(), [](const BuildTri& t) { return !t.alive; }),
+                   tris.end());
+        return tris;
+    }
+}
+
+std::shared_ptr<const HullData> HullData::Build(const std::vector<glm::vec3>& points) {
+    if (points.size() < 4) {
+        std::cerr << "HullData::Build: need at least 4 points\n";
+        return nullptr;
+    }
+
+    glm::vec3 lo(FLT_MAX), hi(-FLT_MAX);
+    for (const glm::vec3& pt : points) {
+        lo = glm::min(lo, pt);
+        hi = glm::max(hi, pt);
+    }
+    float eps = RELATIVE_EPSILON * glm::length(hi - lo);
+
+    std::vector<BuildTri> tris = BuildTriangles(points, eps);
+    if (tris.empty()) {
+        std::cerr << "HullData::Build: point cloud is degenerate\n";
+        return nullptr;
+    }
+
+    // Group coplanar neighbours, then walk each group's boundary into one polygon
+    std::unordered_map<uint64_t, int> triByEdge;
+    for (int t = 0; t < (int)tris.size(); t++) {
+        for (int k = 0; k < 3; k++) triByEdge[EdgeKey(tris[t].v[k], tris[t].v[(k + 1) % 3])] = t;
+    }
+
+    std::vector<int> group(tris.size(), -1);
+    std::vector<std::vector<int>> polygons;
+    std::vector<glm::vec3> polygonNormals;
+    for (int seed = 0; seed < (int)tris.size(); seed++) {
+        if (group[seed] >= 0) continue;
+
+        int id = (int)polygons.size();
+        std::vector<int> members = {seed};
+        group[seed] = id;
+        for (size_t m = 0; m < members.size(); m++) {
+            const BuildTri& t = tris[members[m]];
+            for (int k = 0; k < 3; k++) {
+                auto it = triByEdge.find(EdgeKey(t.v[(k + 1) % 3], t.v[k]));
+                if (it == triByEdge.end() || group[it->second] >= 0) continue;
+                if (glm::dot(tris[it->second].n, tris[seed].n) < COPLANAR_COS) continue;
+                group[it->second] = id;
+                members.push_back(it->second);
+            }
+        }
+
+        std::unordered_map<int, int> nextVertex;
+        glm::vec3 normal(0.0f);
+        for (int member : members) {
+            const BuildTri& t = tris[member];
+            normal += t.n;
+            for (int k = 0; k < 3; k++) {
+                int a = t.v[k], b = t.v[(k + 1) % 3];
+                auto it = triByEdge.find(EdgeKey(b, a));
+                if (it != triByEdge.end() && group[it->second] == id) continue;
+                nextVertex[a] = b;
+            }
+        }
+
+        std::vector<int> loop;
+        int start = nextVertex.begin()->first;
+        int v = start;
+        do {
+            loop.push_back(v);
+            auto it = nextVertex.find(v);
+            if (it == nextVertex.end()) break;
+            v = it->second;
+        } while (v != start && loop.size() <= nextVertex.size());
+
+        if (v != start || loop.size() != nextVertex.size()) {
+            // Boundary didn't close into a single loop; keep the triangles separate
+            polygons.push_back({tris[seed].v[0], tris[seed].v[1], tris[seed].v[2]});
+            polygonNormals.push_back(tris[seed].n);
+            group[seed] = id;
+            for (size_t m = 1; m < members.size(); m++) {
+                const BuildTri& t = tris[members[m]];
+                group[members[m]] = (int)polygons.size();
+                polygons.push_back({t.v[0], t.v[1], t.v[2]});
+                polygonNormals.push_back(t.n);
+            }
+            continue;
+        }
+        polygons.push_back(loop);
+        polygonNormals.push_back(glm::normalize(normal));
+    }
+
+    auto hull = std::make_shared<HullData>();
+
+    // Keep only hull vertices
+    std::unordered_map<int, uint16_t> remap;
+    for (std::vector<int>& polygon : polygons) {
+        for (int& index : polygon) {
+            auto it = remap.find(index);
+            if (it == remap.end()) {
+                it = remap.emplace(index, (uint16_t)hull->vertices.size()).first;
+                hull->vertices.push_back(points[index]);
+            }
+            index = it->second;
+        }
+    }
+
+    // Half-edges, allocated in twin pairs the first time either direction shows up
+    std::unordered_map<uint64_t, uint16_t> edgeIndex;
+    hull->vertexEdges.assign(hull->vertices.size(), 0);
+    for (size_t f = 0; f < polygons.size(); f++) {
+        const std::vector<int>& polygon = polygons[f];
+        size_t count = polygon.size();
+        std::vector<uint16_t> loopEdges(count);
+        for (size_t k = 0; k < count; k++) {
+            int a = polygon[k], b = polygon[(k + 1) % count];
+            uint16_t e;
+            auto it = edgeIndex.find(EdgeKey(a, b));
+            if (it != edgeIndex.end()) {
+                e = it->second;
+            } else {
+                e = (uint16_t)hull->edges.size();
+                hull->edges.resize(hull->edges.size() + 2);
+                edgeIndex[EdgeKey(b, a)] = e + 1;
+            }
+            hull->edges[e].origin = (uint16_t)a;
+            hull->edges[e].face = (uint16_t)f;
+            hull->vertexEdges[a] = e;
+            loopEdges[k] = e;
+        }
+        for (size_t k = 0; k < count; k++) hull->edges[loopEdges[k]].next = loopEdges[(k + 1) % count];
+
+        HullFace face;
+        face.edge = loopEdges[0];
+        face.normal = polygonNormals[f];
+        face.offset = -FLT_MAX;
+        for (int index : polygon) face.offset = std::max(face.offset, glm::dot(face.normal, hull->vertices[index]));
+        hull->faces.push_back(face);
+    }
+
+    hull->ComputeMassProperties();
+    return hull;
+}
+
+std::shared_ptr<const HullData> HullData::MakeBox(const glm::vec3& halfExtents) {
+    std::vector<glm::vec3> corners;
+    for (int x = -1; x <= 1; x += 2)
+        for (int y = -1; y <= 1; y += 2)
+            for (int z = -1; z <= 1; z += 2)
+                corners.push_back(glm::vec3(x, y, z) * halfExtents);
+    return Build(corners);
+}
+
+int HullData::SupportIndex(const glm::vec3& dir, int start) const {
+    int v = start;
+    float best = glm::dot(vertices[v], dir);
+    for (;;) {
+        bool moved = false;
+        uint16_t first = vertexEdges[v];
+        uint16_t e = first;
+        do {
+            int neighbour = edges[Twin(e)].origin;
+            float d = glm::dot(vertices[neighbour], dir);
+            if (d > best) {
+                best = d;
+                v = neighbour;
+                moved = true;
+                break;
+            }
+            e = edges[Twin(e)].next;
+        } while (e != first);
+        if (!moved) return v;
+    }
+}
+
+// Sum of signed tetrahedra from the origin to each face triangle (unit density)
+void HullData::ComputeMassProperties() {
+    const glm::mat3 canonical = glm::mat3(2, 1, 1, 1, 2, 1, 1, 1, 2) * (1.0f / 120.0f);
+
+    glm::vec3 reference(0.0f);
+    for (const glm::vec3& v : vertices) reference += v;
+    reference /= (float)vertices.size();
+
+    float totalVolume = 0.0f;
+    glm::vec3 weightedCenter(0.0f);
+    glm::mat3 covariance(0.0f);
+    for (const HullFace& face : faces) {
+        uint16_t e0 = face.edge;
+        glm::vec3 a = vertices[edges[e0].origin] - reference;
+        for (uint16_t e = edges[e0].next; edges[e].next != e0; e = edges[e].next) {
+            glm::vec3 b = vertices[edges[e].origin] - reference;
+            glm::vec3 c = vertices[edges[edges[e].next].origin] - reference;
+            glm::mat3 A(a, b, c);
+            float det = glm::dot(a, glm::cross(b, c));
+            totalVolume += det / 6.0f;
+            weightedCenter += (a + b + c) * (det / 24.0f);
+            covariance += A * canonical * glm::transpose(A) * det;
+        }
+    }
+
+    volume = totalVolume;
+    glm::vec3 center = weightedCenter / totalVolume;
+    covariance -= glm::outerProduct(center, center) * totalVolume;
+    float trace = covariance[0][0] + covariance[1][1] + covariance[2][2];
+    inertiaPerMass = (glm::mat3(trace) - covariance) * (1.0f / totalVolume);
+
+    // Recenter on the center of mass so body.position is the COM
+    glm::vec3 shift = reference + center;
+    boundsMin = glm::vec3(FLT_MAX);
+    boundsMax = glm::vec3(-FLT_MAX);
+    for (glm::vec3& v : vertices) {
+        v -= shift;
+        boundsMin = glm::min(boundsMin, v);
+        boundsMax = glm::max(boundsMax, v);
+    }
+    for (HullFace& face : faces) face.offset -= glm::dot(face.normal, shift);
+}
@@ -0,0 +1,50 @@
+// src/physics/shapes/HullData.h
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Half-edges are stored in twin pairs (e and e ^ 1)
+struct HullHalfEdge {
+    uint16_t next;    // Next edge around the same face
+    uint16_t origin;  // Vertex the edge starts at
+    uint16_t face;    // Face on the edge's left
+};
+
+struct HullFace {
+    uint16_t edge;    // Any edge on the face's boundary
+    glm::vec3 normal;
+    float offset;     // dot(normal, p) == offset on the face plane
+};
+
+// Immutable polytope built once at load time and shared by every body that
+// uses it. Vertices are centered on the center of mass.
+class HullData {
+public:
+    std::vector<glm::vec3> vertices;
+    std::vector<uint16_t> vertexEdges;  // One outgoing half-edge per vertex
+    std::vector<HullHalfEdge> edges;
+    std::vector<HullFace> faces;
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+    float volume = 0.0f;
+    glm::mat3 inertiaPerMass;  // About the center of mass; scale by the body's mass
+
+    // Quickhull-style incremental build with coplanar triangles merged into
+    // polygons. Returns nullptr for degenerate (flat or tiny) point clouds.
+    static std::shared_ptr<const HullData> Build(const std::vector<glm::vec3>& points);
+    static std::shared_ptr<const HullData> MakeBox(const glm::vec3& halfExtents);
+
+    uint16_t Twin(uint16_t e) const { return e ^ 1; }
+
+    // Hill climb over the edge graph towards dir; start from a previous result when available
+    int SupportIndex(const glm::vec3& dir, int start = 0) const;
+
+    glm::vec3 Support(const glm::vec3& dir) const {
+        return vertices[SupportIndex(dir)];
+    }
+
+private:
+    void ComputeMassProperties();
+};
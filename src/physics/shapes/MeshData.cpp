@@ -0,0 +1,189 @@
+#include "MeshData.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <unordered_map>
+
+namespace {
+    constexpr float QUANTIZED_MAX = 65535.0f;
+    constexpr int MAX_DEPTH = 64;  // Traversal stack size; median splits stay far below this
+    constexpr float CONVEX_EPSILON = 1e-4f;  // Relative bend below which an edge counts as flat
+
+    struct BuildContext {
+        const std::vector<glm::vec3>& vertices;
+        const std::vector<uint32_t>& indices;
+        std::vector<glm::vec3> centroids;
+        std::vector<uint32_t> order;
+    };
+
+    void TriangleBounds(const BuildContext& ctx, uint32_t t, glm::vec3& lo, glm::vec3& hi) {
+        for (int k = 0; k < 3; k++) {
+            const glm::vec3& v = ctx.vertices[ctx.indices[t * 3 + k]];
+            lo = glm::min(lo, v);
+            hi = glm::max(hi, v);
+        }
+    }
+}
+
+void MeshData::Quantize(const glm::vec3& lo, const glm::vec3& hi, uint16_t* qMin, uint16_t* qMax) const {
+    glm::vec3 a = (lo - boundsMin) * quantizeScale;
+    glm::vec3 b = (hi - boundsMin) * quantizeScale;
+    for (int k = 0; k < 3; k++) {
+        qMin[k] = (uint16_t)glm::clamp(std::floor(a[k]), 0.0f, QUANTIZED_MAX);
+        qMax[k] = (uint16_t)glm::clamp(std::ceil(b[k]), 0.0f, QUANTIZED_MAX);
+    }
+}
+
+AABB MeshData::NodeBounds(const MeshBVHNode& node) const {
+    glm::vec3 lo(node.min[0], node.min[1], node.min[2]);
+    glm::vec3 hi(node.max[0], node.max[1], node.max[2]);
+    return AABB(boundsMin + lo / quantizeScale, boundsMin + hi / quantizeScale);
+}
+
+std::shared_ptr<const MeshData> MeshData::Build(const std::vector<glm::vec3>& vertices,
+                                                const std::vector<uint32_t>& indices) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || indices.size() % 3 != 0 || triangleCount > MeshBVHNode::FIRST_MASK) {
+        std::cerr << "MeshData::Build: bad index buffer\n";
+        return nullptr;
+    }
+
+    auto mesh = std::make_shared<MeshData>();
+    mesh->vertices = vertices;
+    mesh->boundsMin = glm::vec3(FLT_MAX);
+    mesh->boundsMax = glm::vec3(-FLT_MAX);
+    for (const glm::vec3& v : vertices) {
+        mesh->boundsMin = glm::min(mesh->boundsMin, v);
+        mesh->boundsMax = glm::max(mesh->boundsMax, v);
+    }
+    glm::vec3 extent = glm::max(mesh->boundsMax - mesh->boundsMin, glm::vec3(1e-6f));
+    mesh->quantizeScale = glm::vec3(QUANTIZED_MAX) / extent;
+
+    BuildContext ctx{vertices, indices, {}, {}};
+    ctx.centroids.resize(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++) {
+        ctx.centroids[t] = (vertices[indices[t * 3]] + vertices[indices[t * 3 + 1]] +
+                            vertices[indices[t * 3 + 2]]) / 3.0f;
+    }
+    ctx.order.resize(triangleCount);
+    std::iota(ctx.order.begin(), ctx.order.end(), 0);
+    mesh->nodes.reserve(triangleCount * 2 / MAX_LEAF_TRIANGLES + 1);
+
+    // Depth-first: a node's left child follows it directly, the right child
+    // comes after the whole left subtree
+    MeshData& m = *mesh;
+    auto build = [&](auto& self, uint32_t begin, uint32_t end) -> uint32_t {
+        uint32_t index = (uint32_t)m.nodes.size();
+        m.nodes.emplace_back();
+
+        glm::vec3 lo(FLT_MAX), hi(-FLT_MAX);
+        glm::vec3 centerLo(FLT_MAX), centerHi(-FLT_MAX);
+        for (uint32_t i = begin; i < end; i++) {
+            TriangleBounds(ctx, ctx.order[i], lo, hi);
+            centerLo = glm::min(centerLo, ctx.centroids[ctx.order[i]]);
+            centerHi = glm::max(centerHi, ctx.centroids[ctx.order[i]]);
+        }
+        m.Quantize(lo, hi, m.nodes[index].min, m.nodes[index].max);
+
+        uint32_t count = end - begin;
+        if (count <= (uint32_t)MAX_LEAF_TRIANGLES) {
+            m.nodes[index].payload = MeshBVHNode::LEAF_FLAG | ((count - 1) << MeshBVHNode::COUNT_SHIFT) | begin;
+            return index;
+        }
+
+        // Median split on the widest centroid axis
+        glm::vec3 spread = centerHi - centerLo;
+        int axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+        uint32_t mid = begin + count / 2;
+        std::nth_element(ctx.order.begin() + begin, ctx.order.begin() + mid, ctx.order.begin() + end,
+                         [&](uint32_t x, uint32_t y) { return ctx.centroids[x][axis] < ctx.centroids[y][axis]; });
+
+        self(self, begin, mid);
+        uint32_t right = self(self, mid, end);
+        m.nodes[index].payload = right;
+        return index;
+    };
+    build(build, 0, (uint32_t)triangleCount);
+
+    mesh->indices.resize(indices.size());
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) mesh->indices[t * 3 + k] = indices[ctx.order[t] * 3 + k];
+    }
+
+    // An edge is convex when the neighbour's far vertex drops below this triangle's plane
+    struct EdgeOwners {
+        uint32_t first = UINT32_MAX;
+        uint32_t second = UINT32_MAX;
+    };
+    auto edgeKey = [&](uint32_t t, int k) {
+        uint32_t a = mesh->indices[t * 3 + k], b = mesh->indices[t * 3 + (k + 1) % 3];
+        return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+    };
+    std::unordered_map<uint64_t, EdgeOwners> owners;
+    for (uint32_t t = 0; t < (uint32_t)triangleCount; t++) {
+        for (int k = 0; k < 3; k++) {
+            EdgeOwners& o = owners[edgeKey(t, k)];
+            if (o.first == UINT32_MAX) o.first = t;
+            else o.second = t;
+        }
+    }
+
+    mesh->convexEdges.assign(triangleCount, 0);
+    for (uint32_t t = 0; t < (uint32_t)triangleCount; t++) {
+        glm::vec3 v0, v1, v2;
+        mesh->GetTriangle(t, v0, v1, v2);
+        glm::vec3 n = glm::cross(v1 - v0, v2 - v0);
+        float scale = glm::length(n);
+        for (int k = 0; k < 3; k++) {
+            const EdgeOwners& o = owners[edgeKey(t, k)];
+            uint32_t neighbour = o.first == t ? o.second : o.first;
+            bool convex = true;  // Open edges are exposed
+            if (neighbour != UINT32_MAX) {
+                uint32_t a = mesh->indices[t * 3 + k], b = mesh->indices[t * 3 + (k + 1) % 3];
+                uint32_t far = a;
+                for (int m = 0; m < 3; m++) {
+                    uint32_t index = mesh->indices[neighbour * 3 + m];
+                    if (index != a && index != b) far = index;
+                }
+                convex = glm::dot(n, mesh->vertices[far] - v0) < -CONVEX_EPSILON * scale;
+            }
+            if (convex) mesh->convexEdges[t] |= (uint8_t)(1u << k);
+        }
+    }
+    return mesh;
+}
+
+void MeshData::QueryAABB(const AABB& box, std::vector<uint32_t>& outTriangles) const {
+    if (box.min.x > boundsMax.x || box.min.y > boundsMax.y || box.min.z > boundsMax.z ||
+        box.max.x < boundsMin.x || box.max.y < boundsMin.y || box.max.z < boundsMin.z) {
+        return;
+    }
+
+    // Compare in quantized space so the hot loop never touches floats
+    uint16_t qMin[3], qMax[3];
+    Quantize(box.min, box.max, qMin, qMax);
+
+    uint32_t stack[MAX_DEPTH];
+    int top = 0;
+    uint32_t index = 0;
+    for (;;) {
+        const MeshBVHNode& node = nodes[index];
+        bool overlaps = node.min[0] <= qMax[0] && node.max[0] >= qMin[0] &&
+                        node.min[1] <= qMax[1] && node.max[1] >= qMin[1] &&
+                        node.min[2] <= qMax[2] && node.max[2] >= qMin[2];
+        if (overlaps) {
+            if (node.IsLeaf()) {
+                uint32_t first = node.FirstTriangle();
+                for (uint32_t t = 0; t < node.TriangleCount(); t++) outTriangles.push_back(first + t);
+            } else {
+                stack[top++] = node.RightChild();
+                index++;
+                continue;
+            }
+        }
+        if (top == 0) break;
+        index = stack[--top];
+    }
+}
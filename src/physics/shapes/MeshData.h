@@ -0,0 +1,67 @@
+// src/physics/shapes/MeshData.h
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../collision/AABB.h"
+
+// 16 bytes, four to a cache line. Bounds are quantized to 16 bits against
+// the mesh bounds and rounded outwards, so they only ever grow.
+struct MeshBVHNode {
+    uint16_t min[3];
+    uint16_t max[3];
+    // Interior: index of the right child (the left child is the next node).
+    // Leaf: LEAF_FLAG | (count - 1) << COUNT_SHIFT | first triangle.
+    uint32_t payload;
+
+    static constexpr uint32_t LEAF_FLAG = 0x80000000u;
+    static constexpr uint32_t COUNT_SHIFT = 27;
+    static constexpr uint32_t FIRST_MASK = (1u << COUNT_SHIFT) - 1;
+
+    bool IsLeaf() const { return (payload & LEAF_FLAG) != 0; }
+    uint32_t RightChild() const { return payload; }
+    uint32_t FirstTriangle() const { return payload & FIRST_MASK; }
+    uint32_t TriangleCount() const { return ((payload >> COUNT_SHIFT) & 0xF) + 1; }
+};
+
+// Static triangle soup with a flattened, depth-first BVH, built once at
+// load time and shared through the ShapeRegistry.
+class MeshData {
+public:
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;   // Three per triangle, reordered to match the leaves
+    std::vector<MeshBVHNode> nodes;
+    // Per triangle, bit j set if edge j (vertex j to j+1) is convex or open.
+    // Flat and concave edges are internal and never produce edge normals.
+    std::vector<uint8_t> convexEdges;
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+
+    static constexpr int MAX_LEAF_TRIANGLES = 4;
+
+    static std::shared_ptr<const MeshData> Build(const std::vector<glm::vec3>& vertices,
+                                                 const std::vector<uint32_t>& indices);
+
+    size_t TriangleCount() const { return indices.size() / 3; }
+
+    void GetTriangle(uint32_t t, glm::vec3& a, glm::vec3& b, glm::vec3& c) const {
+        a = vertices[indices[t * 3]];
+        b = vertices[indices[t * 3 + 1]];
+        c = vertices[indices[t * 3 + 2]];
+    }
+
+    bool IsEdgeConvex(uint32_t t, int edge) const {
+        return (convexEdges[t] >> edge) & 1;
+    }
+
+    // Triangles whose leaf bounds overlap box (in the mesh's local frame)
+    void QueryAABB(const AABB& box, std::vector<uint32_t>& outTriangles) const;
+
+    AABB NodeBounds(const MeshBVHNode& node) const;
+
+private:
+    glm::vec3 quantizeScale;  // Local units to 16-bit steps
+
+    void Quantize(const glm::vec3& lo, const glm::vec3& hi, uint16_t* qMin, uint16_t* qMax) const;
+};
@@ -0,0 +1,29 @@
+// src/physics/shapes/PlaneShape.h
+#pragma once
+#include <glm/glm.hpp>
+#include <limits>
+#include "../collision/AABB.h"
+
+// Infinite half-space: solid where dot(normal, x) < offset
+class PlaneShape {
+public:
+    glm::vec3 normal;
+    float offset;
+
+    PlaneShape(const glm::vec3& normal, float offset)
+        : normal(glm::normalize(normal)), offset(offset) {}
+
+    float SignedDistance(const glm::vec3& point) const {
+        return glm::dot(normal, point) - offset;
+    }
+
+    glm::vec3 GetSize() const {
+        return glm::vec3(0.0f);
+    }
+
+    AABB ComputeAABB(const glm::vec3&, const glm::mat3&) const {
+        // Unbounded; planes are kept out of the broadphase
+        glm::vec3 inf(std::numeric_limits<float>::max());
+        return AABB(-inf, inf);
+    }
+};
@@ -1,12 +1,42 @@
 // src/physics/shapes/Shape.h
 #pragma once
-#include <glm/glm.hpp>
-#include "../collision/AABB.h"
+#include <concepts>
+#include <cstdint>
+#include <variant>
+#include "BoxShape.h"
+#include "SphereShape.h"
+#include "PlaneShape.h"
+#include "CapsuleShape.h"
+#include "ConvexHullShape.h"
+#include "TriangleMeshShape.h"
+#include "HeightfieldShape.h"
+#include "VoxelWorldShape.h"
+#include "CompoundShape.h"
 
-class Shape {
-public:
-    virtual ~Shape() = default;
+// Closed set of collision shapes, stored by value in each RigidBody.
+// ShapeType values match the variant indices; the collision dispatch
+// table is generated from this list.
+using Shape = std::variant<BoxShape, SphereShape, PlaneShape, CapsuleShape, ConvexHullShape,
+                           TriangleMeshShape, HeightfieldShape, VoxelWorldShape, CompoundShape>;
 
-    // 👇 This line is the fix
-    virtual AABB ComputeAABB(const glm::vec3& position) const = 0;
-};
\ No newline at end of file
+enum class ShapeType : uint8_t {
+    Box,
+    Sphere,
+    Plane,
+    Capsule,
+    ConvexHull,
+    TriangleMesh,
+    Heightfield,
+    VoxelWorld,
+    Compound,
+};
+
+constexpr size_t SHAPE_TYPE_COUNT = std::variant_size_v<Shape>;
+
+// Shapes usable by GJK/EPA: a local-space support mapping of the core shape,
+// plus a margin the core is inflated by (sphere and capsule radius).
+template <class S>
+concept ConvexShape = requires(const S& shape, const glm::vec3& dir) {
+    { shape.Support(dir) } -> std::convertible_to<glm::vec3>;
+    { shape.GetMargin() } -> std::convertible_to<float>;
+};
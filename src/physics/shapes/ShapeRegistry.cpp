@@ -0,0 +1,88 @@
+#include "ShapeRegistry.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+    std::mutex registryMutex;
+    std::unordered_map<std::string, std::shared_ptr<const HullData>> hulls;
+    std::unordered_map<std::string, std::shared_ptr<const MeshData>> meshes;
+    std::unordered_map<std::string, std::shared_ptr<const HeightfieldData>> heightfields;
+    std::unordered_map<std::string, std::shared_ptr<const CompoundData>> compounds;
+}
+
+std::shared_ptr<const HullData> ShapeRegistry::RegisterHull(const std::string& name,
+                                                            const std::vector<glm::vec3>& points) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = hulls.find(name);
+    if (it != hulls.end()) return it->second;
+
+    std::shared_ptr<const HullData> hull = HullData::Build(points);
+    if (hull) hulls[name] = hull;
+    return hull;
+}
+
+std::shared_ptr<const HullData> ShapeRegistry::FindHull(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = hulls.find(name);
+    return it != hulls.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<const MeshData> ShapeRegistry::RegisterMesh(const std::string& name,
+                                                            const std::vector<glm::vec3>& vertices,
+                                                            const std::vector<uint32_t>& indices) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = meshes.find(name);
+    if (it != meshes.end()) return it->second;
+
+    std::shared_ptr<const MeshData> mesh = MeshData::Build(vertices, indices);
+    if (mesh) meshes[name] = mesh;
+    return mesh;
+}
+
+std::shared_ptr<const MeshData> ShapeRegistry::FindMesh(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = meshes.find(name);
+    return it != meshes.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<const HeightfieldData> ShapeRegistry::RegisterHeightfield(const std::string& name, int columns, int rows,
+                                                                          float cellSize, const std::vector<float>& heights) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = heightfields.find(name);
+    if (it != heightfields.end()) return it->second;
+
+    std::shared_ptr<const HeightfieldData> field = HeightfieldData::Build(columns, rows, cellSize, heights);
+    if (field) heightfields[name] = field;
+    return field;
+}
+
+std::shared_ptr<const HeightfieldData> ShapeRegistry::FindHeightfield(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = heightfields.find(name);
+    return it != heightfields.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<const CompoundData> ShapeRegistry::RegisterCompound(const std::string& name,
+                                                                    std::vector<CompoundChild> children) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = compounds.find(name);
+    if (it != compounds.end()) return it->second;
+
+    std::shared_ptr<const CompoundData> compound = CompoundData::Build(std::move(children));
+    if (compound) compounds[name] = compound;
+    return compound;
+}
+
+std::shared_ptr<const CompoundData> ShapeRegistry::FindCompound(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = compounds.find(name);
+    return it != compounds.end() ? it->second : nullptr;
+}
+
+void ShapeRegistry::Clear() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    hulls.clear();
+    meshes.clear();
+    heightfields.clear();
+    compounds.clear();
+}
@@ -0,0 +1,36 @@
+// src/physics/shapes/ShapeRegistry.h
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "HullData.h"
+#include "MeshData.h"
+#include "HeightfieldData.h"
+#include "CompoundData.h"
+
+// Owns shape data that's too heavy to copy into every RigidBody. Bodies keep
+// a shared_ptr, so data stays alive until the last user is gone.
+class ShapeRegistry {
+public:
+    // Builds the hull the first time a name is seen; later calls return the same data
+    static std::shared_ptr<const HullData> RegisterHull(const std::string& name,
+                                                        const std::vector<glm::vec3>& points);
+    static std::shared_ptr<const HullData> FindHull(const std::string& name);
+
+    static std::shared_ptr<const MeshData> RegisterMesh(const std::string& name,
+                                                        const std::vector<glm::vec3>& vertices,
+                                                        const std::vector<uint32_t>& indices);
+    static std::shared_ptr<const MeshData> FindMesh(const std::string& name);
+
+    // Heights are row-major, columns * rows samples
+    static std::shared_ptr<const HeightfieldData> RegisterHeightfield(const std::string& name, int columns, int rows,
+                                                                      float cellSize, const std::vector<float>& heights);
+    static std::shared_ptr<const HeightfieldData> FindHeightfield(const std::string& name);
+
+    static std::shared_ptr<const CompoundData> RegisterCompound(const std::string& name,
+                                                                std::vector<CompoundChild> children);
+    static std::shared_ptr<const CompoundData> FindCompound(const std::string& name);
+
+    static void Clear();
+};
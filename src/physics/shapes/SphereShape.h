@@ -1,8 +1,9 @@
 // SphereShape.h
 #pragma once
-#include "Shape.h"
+#include <glm/glm.hpp>
+#include "../collision/AABB.h"
 
-class SphereShape : public Shape {
+class SphereShape {
 public:
     float radius;
 
@@ -12,7 +13,16 @@ public:
         return glm::vec3(radius * 2.0f);
     }
 
-    AABB ComputeAABB(const glm::vec3& position) const override {
+    // The core is the center point; the radius is applied as a margin
+    glm::vec3 Support(const glm::vec3&) const {
+        return glm::vec3(0.0f);
+    }
+
+    float GetMargin() const {
+        return radius;
+    }
+
+    AABB ComputeAABB(const glm::vec3& position, const glm::mat3&) const {
         glm::vec3 rVec(radius);
         return AABB(position - rVec, position + rVec);
     }
@@ -0,0 +1,31 @@
+// src/physics/shapes/TriangleMeshShape.h
+#pragma once
+#include <memory>
+#include <glm/glm.hpp>
+#include "MeshData.h"
+#include "../collision/AABB.h"
+
+// Static level geometry. Not convex, so it never goes through GJK; box and
+// sphere contacts walk the mesh BVH directly.
+class TriangleMeshShape {
+public:
+    std::shared_ptr<const MeshData> mesh;
+
+    explicit TriangleMeshShape(std::shared_ptr<const MeshData> mesh)
+        : mesh(std::move(mesh)) {}
+
+    glm::vec3 GetSize() const {
+        return mesh->boundsMax - mesh->boundsMin;
+    }
+
+    AABB ComputeAABB(const glm::vec3& position, const glm::mat3& rot) const {
+        glm::vec3 center = (mesh->boundsMin + mesh->boundsMax) * 0.5f;
+        glm::vec3 half = (mesh->boundsMax - mesh->boundsMin) * 0.5f;
+        glm::vec3 worldCenter = position + rot * center;
+        glm::vec3 worldHalf =
+            glm::abs(rot[0]) * half.x +
+            glm::abs(rot[1]) * half.y +
+            glm::abs(rot[2]) * half.z;
+        return AABB(worldCenter - worldHalf, worldCenter + worldHalf);
+    }
+};
@@ -0,0 +1,154 @@
+#include "VoxelWorld.h"
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+    constexpr int S = VoxelChunk::SIZE;
+    constexpr int KEY_BITS = 21;
+    constexpr int KEY_OFFSET = 1 << (KEY_BITS - 1);
+    constexpr uint64_t KEY_MASK = (1ull << KEY_BITS) - 1;
+
+    int FloorDiv(int v, int d) {
+        return v >= 0 ? v / d : -((-v + d - 1) / d);
+    }
+}
+
+uint64_t VoxelWorld::ChunkKey(const glm::ivec3& chunk) {
+    return (static_cast<uint64_t>(chunk.x + KEY_OFFSET) & KEY_MASK) |
+           ((static_cast<uint64_t>(chunk.y + KEY_OFFSET) & KEY_MASK) << KEY_BITS) |
+           ((static_cast<uint64_t>(chunk.z + KEY_OFFSET) & KEY_MASK) << (KEY_BITS * 2));
+}
+
+glm::ivec3 VoxelWorld::ChunkCoords(uint64_t key) {
+    return glm::ivec3((int)(key & KEY_MASK) - KEY_OFFSET,
+                      (int)((key >> KEY_BITS) & KEY_MASK) - KEY_OFFSET,
+                      (int)((key >> (KEY_BITS * 2)) & KEY_MASK) - KEY_OFFSET);
+}
+
+glm::ivec3 VoxelWorld::ChunkOf(const glm::vec3& localPoint) const {
+    glm::vec3 c = glm::floor(localPoint / (voxelSize * S));
+    c = glm::clamp(c, glm::vec3(1 - KEY_OFFSET), glm::vec3(KEY_OFFSET - 1));
+    return glm::ivec3(c);
+}
+
+bool VoxelWorld::ClipToBounds(const AABB& query, AABB& clipped) const {
+    for (int axis = 0; axis < 3; axis++) {
+        // Written so a NaN comparison picks the bounds
+        clipped.min[axis] = query.min[axis] > boundsMin[axis] ? query.min[axis] : boundsMin[axis];
+        clipped.max[axis] = query.max[axis] < boundsMax[axis] ? query.max[axis] : boundsMax[axis];
+        if (clipped.min[axis] > clipped.max[axis]) return false;
+    }
+    return true;
+}
+
+void VoxelWorld::ChunksIn(const glm::ivec3& lo, const glm::ivec3& hi, std::vector<uint64_t>& keys) const {
+    for (const auto& [key, chunk] : chunks) {
+        glm::ivec3 c = ChunkCoords(key);
+        bool inside = c.x >= lo.x && c.y >= lo.y && c.z >= lo.z && c.x <= hi.x && c.y <= hi.y && c.z <= hi.z;
+        if (inside) keys.push_back(key);
+    }
+    // Keys hold z above y above x, each offset to stay positive, so numeric
+    // order is the grid walk's order and hash map order never leaks out
+    std::sort(keys.begin(), keys.end());
+}
+
+void VoxelWorld::SetVoxel(const glm::ivec3& voxel, bool solid) {
+    glm::ivec3 chunkCoords(FloorDiv(voxel.x, S), FloorDiv(voxel.y, S), FloorDiv(voxel.z, S));
+    glm::ivec3 local = voxel - chunkCoords * S;
+    uint64_t key = ChunkKey(chunkCoords);
+
+    auto it = chunks.find(key);
+    if (it == chunks.end()) {
+        if (!solid) return;
+        it = chunks.emplace(key, VoxelChunk()).first;
+    }
+
+    VoxelChunk& chunk = it->second;
+    uint16_t& row = chunk.rows[local.z * S + local.y];
+    uint16_t bit = (uint16_t)(1u << local.x);
+    uint16_t updated = solid ? (uint16_t)(row | bit) : (uint16_t)(row & ~bit);
+    if (updated == row) return;
+
+    row = updated;
+    if (!chunk.dirty) {
+        chunk.dirty = true;
+        dirtyChunks.push_back(key);
+    }
+}
+
+bool VoxelWorld::IsSolid(const glm::ivec3& voxel) const {
+    glm::ivec3 chunkCoords(FloorDiv(voxel.x, S), FloorDiv(voxel.y, S), FloorDiv(voxel.z, S));
+    auto it = chunks.find(ChunkKey(chunkCoords));
+    if (it == chunks.end()) return false;
+    glm::ivec3 local = voxel - chunkCoords * S;
+    return (it->second.rows[local.z * S + local.y] >> local.x) & 1;
+}
+
+bool VoxelWorld::RebuildDirtyChunks(std::vector<AABB>& changedRegions) {
+    if (dirtyChunks.empty()) return false;
+
+    for (uint64_t key : dirtyChunks) {
+        auto it = chunks.find(key);
+        if (it == chunks.end()) continue;
+        VoxelChunk& chunk = it->second;
+
+        if (!chunk.boxes.empty()) changedRegions.push_back(chunk.bounds);
+        MergeChunk(ChunkCoords(key), chunk);
+        chunk.dirty = false;
+
+        if (chunk.boxes.empty()) chunks.erase(it);
+        else changedRegions.push_back(chunk.bounds);
+    }
+    dirtyChunks.clear();
+
+    boundsMin = glm::vec3(FLT_MAX);
+    boundsMax = glm::vec3(-FLT_MAX);
+    for (const auto& [key, chunk] : chunks) {
+        boundsMin = glm::min(boundsMin, chunk.bounds.min);
+        boundsMax = glm::max(boundsMax, chunk.bounds.max);
+    }
+    if (chunks.empty()) boundsMin = boundsMax = glm::vec3(0.0f);
+    return true;
+}
+
+void VoxelWorld::MergeChunk(const glm::ivec3& chunkCoords, VoxelChunk& chunk) const {
+    chunk.boxes.clear();
+    chunk.bounds = AABB(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+
+    // Greedy: grow each run along X, then Y, then Z while the whole face is
+    // still solid and unclaimed. Whole rows are tested with one mask compare.
+    std::array<uint16_t, S * S> remaining = chunk.rows;
+    glm::vec3 origin = glm::vec3(chunkCoords * S) * voxelSize;
+    for (int z = 0; z < S; z++) {
+        for (int y = 0; y < S; y++) {
+            while (remaining[z * S + y] != 0) {
+                uint32_t row = remaining[z * S + y];
+                int x0 = std::countr_zero(row);
+                int width = std::countr_one(row >> x0);
+                uint16_t mask = (uint16_t)(((1u << width) - 1) << x0);
+
+                int y1 = y + 1;
+                while (y1 < S && (remaining[z * S + y1] & mask) == mask) y1++;
+
+                int z1 = z + 1;
+                for (; z1 < S; z1++) {
+                    bool solid = true;
+                    for (int yy = y; yy < y1 && solid; yy++) solid = (remaining[z1 * S + yy] & mask) == mask;
+                    if (!solid) break;
+                }
+
+                for (int zz = z; zz < z1; zz++) {
+                    for (int yy = y; yy < y1; yy++) remaining[zz * S + yy] &= (uint16_t)~mask;
+                }
+
+                glm::vec3 lo = origin + glm::vec3(x0, y, z) * voxelSize;
+                glm::vec3 hi = origin + glm::vec3(x0 + width, y1, z1) * voxelSize;
+                chunk.boxes.push_back({(lo + hi) * 0.5f, (hi - lo) * 0.5f});
+                chunk.bounds.min = glm::min(chunk.bounds.min, lo);
+                chunk.bounds.max = glm::max(chunk.bounds.max, hi);
+            }
+        }
+    }
+}
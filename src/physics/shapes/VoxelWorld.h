@@ -0,0 +1,89 @@
+// src/physics/shapes/VoxelWorld.h
+#pragma once
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../collision/AABB.h"
+
+// Solid voxels greedily merged into one axis-aligned box (local frame)
+struct VoxelBox {
+    glm::vec3 center;
+    glm::vec3 halfExtents;
+};
+
+struct VoxelChunk {
+    static constexpr int SIZE = 16;
+
+    // One 16-bit row along X per (y, z): bit x of rows[z * SIZE + y]
+    std::array<uint16_t, SIZE * SIZE> rows{};
+    std::vector<VoxelBox> boxes;
+    AABB bounds;  // Of the boxes, local frame
+    bool dirty = false;
+};
+
+// Editable voxel terrain split into 16^3 chunks. Edits only flag their
+// chunk; RebuildDirtyChunks re-merges those chunks once, before the step.
+class VoxelWorld {
+public:
+    float voxelSize = 1.0f;
+    std::unordered_map<uint64_t, VoxelChunk> chunks;
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+
+    explicit VoxelWorld(float voxelSize) : voxelSize(voxelSize) {}
+
+    void SetVoxel(const glm::ivec3& voxel, bool solid);
+    bool IsSolid(const glm::ivec3& voxel) const;
+
+    // Re-merges flagged chunks and refreshes the bounds. Appends the local
+    // region each rebuilt chunk covered before and after; false if nothing changed.
+    bool RebuildDirtyChunks(std::vector<AABB>& changedRegions);
+
+    // Merged boxes that overlap query (local frame), chunk by chunk in z, y, x order
+    template <class Fn>
+    void ForEachBox(const AABB& query, Fn&& fn) const {
+        AABB clipped;
+        if (!ClipToBounds(query, clipped)) return;
+        auto visit = [&](const VoxelChunk& chunk) {
+            if (!chunk.bounds.Overlaps(clipped)) return;
+            for (const VoxelBox& box : chunk.boxes) {
+                AABB bounds(box.center - box.halfExtents, box.center + box.halfExtents);
+                if (bounds.Overlaps(clipped)) fn(box);
+            }
+        };
+
+        glm::ivec3 lo = ChunkOf(clipped.min), hi = ChunkOf(clipped.max);
+        uint64_t span = uint64_t(hi.x - lo.x + 1) * uint64_t(hi.y - lo.y + 1) * uint64_t(hi.z - lo.z + 1);
+        if (span > chunks.size()) {
+            // More coordinates than chunks, e.g. a long diagonal sweep: walk
+            // the chunks that exist instead of hashing every coordinate
+            std::vector<uint64_t> keys;
+            ChunksIn(lo, hi, keys);
+            for (uint64_t key : keys) visit(chunks.at(key));
+            return;
+        }
+        for (int z = lo.z; z <= hi.z; z++) {
+            for (int y = lo.y; y <= hi.y; y++) {
+                for (int x = lo.x; x <= hi.x; x++) {
+                    auto it = chunks.find(ChunkKey(glm::ivec3(x, y, z)));
+                    if (it != chunks.end()) visit(it->second);
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> dirtyChunks;
+
+    glm::ivec3 ChunkOf(const glm::vec3& localPoint) const;
+    // query cut down to the world's bounds; false if nothing is left. A NaN
+    // or infinite side, e.g. from an unbounded sweep, takes the bounds' side.
+    bool ClipToBounds(const AABB& query, AABB& clipped) const;
+    // Keys of the existing chunks between lo and hi, in the grid walk's order
+    void ChunksIn(const glm::ivec3& lo, const glm::ivec3& hi, std::vector<uint64_t>& keys) const;
+    static uint64_t ChunkKey(const glm::ivec3& chunk);
+    static glm::ivec3 ChunkCoords(uint64_t key);
+    void MergeChunk(const glm::ivec3& chunkCoords, VoxelChunk& chunk) const;
+};
@@ -0,0 +1,31 @@
+// src/physics/shapes/VoxelWorldShape.h
+#pragma once
+#include <memory>
+#include <glm/glm.hpp>
+#include "VoxelWorld.h"
+#include "../collision/AABB.h"
+
+// Static, editable voxel terrain. Unlike the other shared shape data the
+// world is mutable: edits are made between steps and merged at step start.
+class VoxelWorldShape {
+public:
+    std::shared_ptr<VoxelWorld> world;
+
+    explicit VoxelWorldShape(std::shared_ptr<VoxelWorld> world)
+        : world(std::move(world)) {}
+
+    glm::vec3 GetSize() const {
+        return world->boundsMax - world->boundsMin;
+    }
+
+    AABB ComputeAABB(const glm::vec3& position, const glm::mat3& rot) const {
+        glm::vec3 center = (world->boundsMin + world->boundsMax) * 0.5f;
+        glm::vec3 half = (world->boundsMax - world->boundsMin) * 0.5f;
+        glm::vec3 worldCenter = position + rot * center;
+        glm::vec3 worldHalf =
+            glm::abs(rot[0]) * half.x +
+            glm::abs(rot[1]) * half.y +
+            glm::abs(rot[2]) * half.z;
+        return AABB(worldCenter - worldHalf, worldCenter + worldHalf);
+    }
+};